@@ -0,0 +1,153 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include "Trace.hpp"
+
+// Политики выделения памяти для узлов контейнеров (см. HashMap).
+// Обращения к куче считаются в трассировке здесь, в строке HashMap.
+// Интерфейс политики:
+//   void* Allocate(size_t bytes)
+//   void  Deallocate(void* p, size_t bytes)
+//   void  Reset()                — освободить всё разом (если умеет)
+//   static const bool kBulkRelease — true, если Reset освобождает все блоки
+//                                    и поштучный Deallocate перед ним не нужен
+
+// Обычная куча: каждый узел — отдельные new/delete
+struct HeapAllocator {
+    static const bool kBulkRelease = false;
+
+    void* Allocate(size_t bytes) {
+        LAB2_TRACE_EVENT(HashMap, Allocations, 1);
+        LAB2_TRACE_EVENT(HashMap, AllocatedBytes, bytes);
+        return ::operator new(bytes);
+    }
+
+    void Deallocate(void* p, size_t) {
+        ::operator delete(p);
+    }
+
+    void Reset() {}
+};
+
+// Bump-арена со списками свободных ячеек по классам размера.
+// Память берётся блоками; освобождённые ячейки возвращаются в список своего
+// класса и переиспользуются. Reset() откатывает арену к началу, сохраняя
+// блоки для следующей партии, деструктор возвращает блоки в кучу.
+class ArenaAllocator {
+public:
+    static const bool kBulkRelease = true;
+
+    explicit ArenaAllocator(size_t blockSize = 16 * 1024)
+    : _blockSize(blockSize < kMaxClassBytes ? kMaxClassBytes : blockSize),
+      _first(nullptr), _current(nullptr), _offset(0), _blockCount(0), _reserved(0)
+    {
+        for (size_t i = 0; i < kClassCount; i++) _freeLists[i] = nullptr;
+    }
+
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+    ~ArenaAllocator() {
+        Block* block = _first;
+        while (block) {
+            Block* next = block->next;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+
+    void* Allocate(size_t bytes) {
+        size_t rounded = RoundUp(bytes == 0 ? 1 : bytes);
+        size_t cls = rounded / kAlign;
+        if (cls < kClassCount && _freeLists[cls]) {
+            FreeCell* cell = _freeLists[cls];
+            _freeLists[cls] = cell->next;
+            return cell;
+        }
+        if (!_current || _offset + rounded > _current->size) NextBlock(rounded);
+        void* p = Payload(_current) + _offset;
+        _offset += rounded;
+        return p;
+    }
+
+    // Крупные ячейки (> kMaxClassBytes) не переиспользуются до Reset()
+    void Deallocate(void* p, size_t bytes) {
+        if (!p) return;
+        size_t cls = RoundUp(bytes == 0 ? 1 : bytes) / kAlign;
+        if (cls >= kClassCount) return;
+        FreeCell* cell = static_cast<FreeCell*>(p);
+        cell->next = _freeLists[cls];
+        _freeLists[cls] = cell;
+    }
+
+    void Reset() {
+        for (size_t i = 0; i < kClassCount; i++) _freeLists[i] = nullptr;
+        _current = _first;
+        _offset = 0;
+    }
+
+    size_t GetBlockCount() const { return _blockCount; }
+    size_t GetBytesReserved() const { return _reserved; }
+
+private:
+    static const size_t kAlign = alignof(std::max_align_t);
+    static const size_t kMaxClassBytes = 256;
+    static const size_t kClassCount = kMaxClassBytes / kAlign + 1;
+
+    struct Block {
+        Block* next;
+        size_t size; // полезный объём
+    };
+
+    struct FreeCell {
+        FreeCell* next;
+    };
+
+    size_t _blockSize;
+    Block* _first;
+    Block* _current;
+    size_t _offset;
+    size_t _blockCount;
+    size_t _reserved;
+    FreeCell* _freeLists[kClassCount];
+
+    static size_t RoundUp(size_t bytes) {
+        return (bytes + kAlign - 1) / kAlign * kAlign;
+    }
+
+    static char* Payload(Block* block) {
+        return reinterpret_cast<char*>(block) + RoundUp(sizeof(Block));
+    }
+
+    // Переходит к следующему блоку, который вмещает rounded байт:
+    // сначала среди сохранённых после Reset(), иначе выделяет новый
+    void NextBlock(size_t rounded) {
+        Block* prev = _current;
+        Block* next = _current ? _current->next : _first;
+        while (next && next->size < rounded) {
+            prev = next;
+            next = next->next;
+        }
+        if (!next) {
+            size_t size = (rounded > _blockSize) ? rounded : _blockSize;
+            void* raw;
+            try {
+                raw = ::operator new(RoundUp(sizeof(Block)) + size);
+            } catch (const std::bad_alloc& e) {
+                throw std::runtime_error("Memory allocation failed in ArenaAllocator");
+            }
+            LAB2_TRACE_EVENT(HashMap, Allocations, 1);
+            LAB2_TRACE_EVENT(HashMap, AllocatedBytes, RoundUp(sizeof(Block)) + size);
+            next = static_cast<Block*>(raw);
+            next->size = size;
+            next->next = nullptr;
+            if (prev) prev->next = next;
+            else _first = next;
+            _blockCount++;
+            _reserved += size;
+        }
+        _current = next;
+        _offset = 0;
+    }
+};
@@ -0,0 +1,191 @@
+#pragma once
+#include "Histogram.hpp"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Тип поля по указателю на член: FieldOf<&Person::age> == int
+template <typename M> struct MemberPointerTraits;
+template <typename C, typename F> struct MemberPointerTraits<F C::*> {
+    typedef C Class;
+    typedef F Field;
+};
+
+template <auto Member>
+using FieldOf = typename MemberPointerTraits<decltype(Member)>::Field;
+
+// Последовательность записей T, у которой выбранные поля (Fields — указатели
+// на члены T) дополнительно хранятся отдельными непрерывными столбцами
+// DynamicArray. Get() возвращает запись целиком из строкового хранилища,
+// а сканы по одному полю (гистограммы, агрегаты) читают только свой столбец.
+template <typename T, auto... Fields>
+class ColumnarSequence : public Sequence<T> {
+    static_assert(sizeof...(Fields) > 0, "ColumnarSequence: at least one column is required");
+
+private:
+    template <auto V> struct Tag {};
+
+    // Номер столбца для указателя на член (sizeof...(Fields), если такого нет)
+    template <auto Member>
+    static constexpr size_t ColumnIndex() {
+        constexpr bool match[] = { std::is_same< Tag<Member>, Tag<Fields> >::value... };
+        for (size_t i = 0; i < sizeof...(Fields); i++)
+            if (match[i]) return i;
+        return sizeof...(Fields);
+    }
+
+    typedef std::tuple< DynamicArray< FieldOf<Fields> >... > Columns;
+    typedef std::index_sequence_for<decltype(Fields)...> ColumnIndices;
+
+    DynamicArray<T> rows;
+    Columns columns;
+    size_t length;
+
+    template <size_t... I>
+    void ResizeColumns(size_t capacity, std::index_sequence<I...>) {
+        (std::get<I>(columns).Resize(capacity), ...);
+    }
+
+    template <size_t... I>
+    void StoreFields(size_t index, const T& item, std::index_sequence<I...>) {
+        ((std::get<I>(columns).GetData()[index] = item.*Fields), ...);
+    }
+
+    template <size_t... I>
+    void ShiftColumns(size_t from, size_t to, std::index_sequence<I...>) {
+        ((std::get<I>(columns).GetData()[to] = std::get<I>(columns).GetData()[from]), ...);
+    }
+
+    void Reserve(size_t needed) {
+        size_t capacity = rows.GetSize();
+        if (needed <= capacity) return;
+        size_t newCapacity = capacity * 2;
+        if (newCapacity < needed) newCapacity = needed;
+        rows.Resize(newCapacity);
+        ResizeColumns(newCapacity, ColumnIndices());
+    }
+
+    void StoreAt(size_t index, const T& item) {
+        rows.GetData()[index] = item;
+        StoreFields(index, item, ColumnIndices());
+    }
+
+public:
+    ColumnarSequence() : rows(8), columns(DynamicArray< FieldOf<Fields> >(8)...), length(0) {}
+
+    ColumnarSequence(const T* items, size_t count)
+    : rows(count ? count : 1), columns(DynamicArray< FieldOf<Fields> >(count ? count : 1)...), length(count)
+    {
+        for (size_t i = 0; i < count; i++)
+            StoreAt(i, items[i]);
+    }
+
+    explicit ColumnarSequence(const Sequence<T>& seq) : ColumnarSequence() {
+        Reserve(seq.GetLength());
+        for (size_t i = 0; i < seq.GetLength(); i++)
+            StoreAt(length++, seq.Get(i));
+    }
+
+    T GetFirst() const override {
+        return Get(0);
+    }
+
+    T GetLast() const override {
+        if (length == 0) throw out_of_range("Sequence is empty");
+        return Get(length - 1);
+    }
+
+    T Get(size_t index) const override {
+        if (index >= length) throw out_of_range("Index out of range");
+        return rows.GetData()[index];
+    }
+
+    size_t GetLength() const override {
+        return length;
+    }
+
+    Sequence<T>* GetSubsequence(size_t start, size_t end) const override {
+        if (start > end || end >= length) throw out_of_range("Invalid range");
+        return new ColumnarSequence<T, Fields...>(rows.GetData() + start, end - start + 1);
+    }
+
+    Sequence<T>* Append(T item) override {
+        Reserve(length + 1);
+        StoreAt(length++, item);
+        return this;
+    }
+
+    Sequence<T>* Prepend(T item) override {
+        return InsertAt(item, 0);
+    }
+
+    Sequence<T>* InsertAt(T item, size_t index) override {
+        if (index > length) throw out_of_range("Index out of range");
+        Reserve(length + 1);
+        T* r = rows.GetData();
+        for (size_t i = length; i > index; i--) {
+            r[i] = r[i - 1];
+            ShiftColumns(i - 1, i, ColumnIndices());
+        }
+        StoreAt(index, item);
+        length++;
+        return this;
+    }
+
+    Sequence<T>* Concat(Sequence<T>* list) const override {
+        auto* result = new ColumnarSequence<T, Fields...>(rows.GetData(), length);
+        result->Reserve(length + list->GetLength());
+        for (size_t i = 0; i < list->GetLength(); i++)
+            result->Append(list->Get(i));
+        return result;
+    }
+
+    void SetAt(size_t index, const T& item) {
+        if (index >= length) throw out_of_range("Index out of range");
+        StoreAt(index, item);
+    }
+
+    // Непрерывный столбец поля Member длиной GetLength()
+    template <auto Member>
+    const FieldOf<Member>* GetColumn() const {
+        constexpr size_t index = ColumnIndex<Member>();
+        static_assert(index < sizeof...(Fields), "ColumnarSequence: field is not a column");
+        return std::get<index>(columns).GetData();
+    }
+};
+
+// Гистограмма по одному столбцу: читается только массив значений поля,
+// бин вычисляется арифметически, proj (по умолчанию — тождественный)
+// встраивается в цикл. Результат того же вида, что у BuildHistogram.
+template <auto Member, typename T, auto... Fields, typename Key, typename Proj>
+IDictionary< Range<Key>, int >*
+BuildColumnHistogram(const ColumnarSequence<T, Fields...>* seq, Key minVal, Key maxVal, int binCount, Proj proj) {
+    if (!seq) throw std::invalid_argument("BuildColumnHistogram: seq is null");
+    if (binCount <= 0) throw std::invalid_argument("BuildColumnHistogram: binCount <= 0");
+
+    ArraySequence< Range<Key> >* bins = MakeUniformBins<Key>(minVal, maxVal, binCount);
+    UniformBinLocator<Key> locate(bins, minVal, maxVal);
+
+    DynamicArray<int> counts(binCount);
+    int* c = counts.GetData();
+    for (int i = 0; i < binCount; ++i) c[i] = 0;
+
+    const FieldOf<Member>* column = seq->template GetColumn<Member>();
+    size_t n = seq->GetLength();
+    for (size_t i = 0; i < n; ++i) {
+        int j = locate(static_cast<Key>(proj(column[i])));
+        if (j >= 0) ++c[j];
+    }
+
+    IDictionary< Range<Key>, int >* dict = MakeHistogramDictionary(bins, c);
+    delete bins;
+    return dict;
+}
+
+template <auto Member, typename T, auto... Fields, typename Key>
+IDictionary< Range<Key>, int >*
+BuildColumnHistogram(const ColumnarSequence<T, Fields...>* seq, Key minVal, Key maxVal, int binCount) {
+    return BuildColumnHistogram<Member>(seq, minVal, maxVal, binCount,
+        [](const FieldOf<Member>& v) { return v; });
+}
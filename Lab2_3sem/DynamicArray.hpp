@@ -1,11 +1,18 @@
 #include <cmath>
 #include <stdexcept>
+#include "ThreadPool.hpp"
+#include "Trace.hpp"
 using namespace std;
 template <typename T> class DynamicArray {
 private:
     T* data;
     size_t size;
 
+    [[noreturn]] static void OutOfRange() {
+        LAB2_TRACE_EVENT(DynamicArray, BoundsFailures, 1);
+        throw out_of_range("Index out of range");
+    }
+
 public:
     DynamicArray(size_t size) : size(size) {
         if (size == 0) throw invalid_argument("Size cannot be zero");
@@ -14,6 +21,8 @@ public:
         } catch (const bad_alloc& e) {
             throw runtime_error("Memory allocation failed in constructor");
         }
+        LAB2_TRACE_EVENT(DynamicArray, Allocations, 1);
+        LAB2_TRACE_EVENT(DynamicArray, AllocatedBytes, size * sizeof(T));
     }
 
     DynamicArray(const T* items, size_t count) : size(count) {
@@ -24,6 +33,9 @@ public:
         } catch (const bad_alloc& e) {
             throw runtime_error("Memory allocation failed in initializer");
         }
+        LAB2_TRACE_EVENT(DynamicArray, Allocations, 1);
+        LAB2_TRACE_EVENT(DynamicArray, AllocatedBytes, count * sizeof(T));
+        LAB2_TRACE_EVENT(DynamicArray, Copies, count);
     }
 
     DynamicArray(const DynamicArray& other) : size(other.size) {
@@ -34,6 +46,9 @@ public:
         } catch (const bad_alloc& e) {
             throw runtime_error("Memory allocation failed in copy constructor");
         }
+        LAB2_TRACE_EVENT(DynamicArray, Allocations, 1);
+        LAB2_TRACE_EVENT(DynamicArray, AllocatedBytes, size * sizeof(T));
+        LAB2_TRACE_EVENT(DynamicArray, Copies, size);
     }
 
     ~DynamicArray() {
@@ -41,12 +56,31 @@ public:
     }
 
     T Get(size_t index) const {
-        if (index >= size) throw out_of_range("Index out of range");
+        if (index >= size) OutOfRange();
+        return data[index];
+    }
+
+    T& GetRef(size_t index) {
+        if (index >= size) OutOfRange();
+        return data[index];
+    }
+
+    const T& GetRef(size_t index) const {
+        if (index >= size) OutOfRange();
         return data[index];
     }
 
+    // Сырой буфер для однопроходных алгоритмов (без проверки границ)
+    T* GetData() {
+        return data;
+    }
+
+    const T* GetData() const {
+        return data;
+    }
+
     void Set(size_t index, T value) {
-        if (index >= size) throw out_of_range("Index out of range");
+        if (index >= size) OutOfRange();
         data[index] = value;
     }
 
@@ -61,6 +95,10 @@ public:
             T* newData = new T[newSize];
             for (size_t i = 0; i < (newSize < size ? newSize : size); i++)
                 newData[i] = data[i];
+            LAB2_TRACE_EVENT(DynamicArray, Resizes, 1);
+            LAB2_TRACE_EVENT(DynamicArray, Allocations, 1);
+            LAB2_TRACE_EVENT(DynamicArray, AllocatedBytes, newSize * sizeof(T));
+            LAB2_TRACE_EVENT(DynamicArray, Copies, newSize < size ? newSize : size);
             delete[] data;
             data = newData;
             size = newSize;
@@ -98,4 +136,51 @@ public:
             sum += static_cast<double>(data[i]) * data[i];
         return std::sqrt(sum);
     }
+
+    // Параллельные перегрузки
+
+    DynamicArray Add(const DynamicArray& other, ThreadPool& pool) const {
+        if (size != other.size) throw invalid_argument("Size mismatch in addition");
+        DynamicArray result(size);
+        ParallelFor(pool, size, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; i++)
+                result.data[i] = data[i] + other.data[i];
+        });
+        return result;
+    }
+
+    DynamicArray Multiply(T scalar, ThreadPool& pool) const {
+        DynamicArray result(size);
+        ParallelFor(pool, size, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; i++)
+                result.data[i] = data[i] * scalar;
+        });
+        return result;
+    }
+
+    T Dot(const DynamicArray& other, ThreadPool& pool, ReduceOrder order = ReduceOrder::Pinned) const {
+        if (size != other.size) throw invalid_argument("Size mismatch in dot product");
+        return ParallelReduceChunks(pool, size, T(),
+            [&](size_t lo, size_t hi) {
+                T part = T();
+                for (size_t i = lo; i < hi; i++)
+                    part += data[i] * other.data[i];
+                return part;
+            },
+            [](const T& a, const T& b) { return a + b; },
+            order);
+    }
+
+    double Norm(ThreadPool& pool, ReduceOrder order = ReduceOrder::Pinned) const {
+        double sum = ParallelReduceChunks(pool, size, 0.0,
+            [&](size_t lo, size_t hi) {
+                double part = 0;
+                for (size_t i = lo; i < hi; i++)
+                    part += static_cast<double>(data[i]) * data[i];
+                return part;
+            },
+            [](double a, double b) { return a + b; },
+            order);
+        return std::sqrt(sum);
+    }
 };
\ No newline at end of file
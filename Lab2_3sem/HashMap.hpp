@@ -0,0 +1,257 @@
+#pragma once
+#include "Arena.hpp"
+#include "Sequence.hpp"
+#include "SmallArraySequence.hpp"
+
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+template <typename T>
+inline T MaxT(const T& a, const T& b) { return (a < b ? b : a); }
+
+template <typename T>
+inline T MinT(const T& a, const T& b) { return (b < a ? b : a); }
+
+static inline int positive_mod(int x, int m) {
+    int r = x % m;
+    return (r < 0) ? (r + m) : r;
+}
+
+template <typename TKey, typename TValue>
+struct KVPair {
+    TKey   key;
+    TValue value;
+};
+
+template <typename TKey, typename TValue>
+class IDictionary {
+public:
+    virtual ~IDictionary() {}
+
+    virtual TValue& Get(const TKey& key) = 0;              // throw, если нет
+    virtual bool    ContainsKey(const TKey& key) = 0;
+    virtual void    Add(const TKey& key, const TValue& v) = 0;   // throw, если есть
+    virtual void    Set(const TKey& key, const TValue& v) = 0;   // upsert
+    virtual void    Remove(const TKey& key) = 0;           // throw, если нет
+
+    virtual int     GetCount() const = 0;
+    virtual int     GetCapacity() const = 0;
+};
+
+// Alloc — политика выделения записей KV (HeapAllocator или ArenaAllocator из Arena.hpp)
+template <typename TKey, typename TValue, typename Alloc = HeapAllocator>
+class HashMap : public IDictionary<TKey, TValue> {
+public:
+    typedef KVPair<TKey, TValue> KV;
+    // Бакет хранит до двух записей прямо в массиве бакетов, без кучи
+    typedef SmallArraySequence<KV*, 2> Bucket;
+
+    HashMap(int (*hashFn)(const TKey&),
+            int initial_capacity = 25,
+            double p = 4.0,
+            double q = 2.0)
+    : _hash(hashFn), _count(0), _capacity(initial_capacity),
+    _p(p), _q(q)
+    {
+        if (!_hash)                 throw std::invalid_argument("HashMap: hashFn is null");
+        if (_capacity < 1)          _capacity = 1;
+        if (!(_p >= _q && _q > 1))  throw std::invalid_argument("HashMap: require p >= q > 1");
+
+        // Все бакеты — одним массивом, изначально пустые
+        _buckets = new DynamicArray<Bucket>(static_cast<size_t>(_capacity));
+    }
+
+    ~HashMap() {
+        // Удаляем записи; бакеты живут внутри массива
+        if (_buckets) {
+            destroy_entries();
+            delete _buckets;
+        }
+    }
+
+    // Удаляет все записи, сохраняя число бакетов и память арены для следующей партии
+    void Clear() {
+        destroy_entries();
+        _count = 0;
+    }
+
+    Alloc& GetAllocator() { return _alloc; }
+
+    // IDictionary
+    TValue& Get(const TKey& key) override {
+        Bucket& bucket = _buckets->GetRef(bucket_index(key));
+        if (bucket.GetLength() == 0) KeyNotFound("Get: key not found (empty bucket)");
+
+        int idx = index_in_bucket(bucket, key);
+        if (idx < 0) KeyNotFound("Get: key not found");
+        return bucket.GetRef(idx)->value;
+    }
+
+    bool ContainsKey(const TKey& key) override {
+        Bucket& bucket = _buckets->GetRef(bucket_index(key));
+        return index_in_bucket(bucket, key) >= 0;
+    }
+
+    void Add(const TKey& key, const TValue& v) override {
+        Bucket& bucket = _buckets->GetRef(bucket_index(key));
+        if (index_in_bucket(bucket, key) >= 0) throw std::invalid_argument("Add: duplicate key");
+
+        insert_to_bucket(bucket, key, v);
+        ++_count;
+
+        if (_count == _capacity) {
+            rehash(static_cast<int>(_capacity * _q)); // grow ×q
+        }
+    }
+
+    void Set(const TKey& key, const TValue& v) override {
+        Bucket& bucket = _buckets->GetRef(bucket_index(key));
+        int idx = index_in_bucket(bucket, key);
+        if (idx >= 0) {
+            bucket.GetRef(idx)->value = v;
+            return;
+        }
+        // не было — вставляем
+        insert_to_bucket(bucket, key, v);
+        ++_count;
+
+        if (_count == _capacity) {
+            rehash(static_cast<int>(_capacity * _q)); // grow ×q
+        }
+    }
+
+    void Remove(const TKey& key) override {
+        Bucket& bucket = _buckets->GetRef(bucket_index(key));
+
+        int m = bucket.GetLength();
+        for (int i = 0; i < m; ++i) {
+            if (equal_keys(bucket.GetRef(i)->key, key)) {
+                free_node(bucket.GetRef(i));
+                bucket.Delete(i);
+                --_count;
+
+                // shrink при n ≤ c/p
+                if (_count <= static_cast<int>(_capacity / _p) && _capacity > 1) {
+                    int newCap = static_cast<int>(_capacity / _q);
+                    if (newCap < 1) newCap = 1;
+                    rehash(newCap);
+                }
+                return;
+            }
+        }
+        KeyNotFound("Remove: key not found");
+    }
+
+    int GetCount() const override    { return _count; }
+    int GetCapacity() const override { return _capacity; }
+
+private:
+    DynamicArray<Bucket>* _buckets = nullptr;
+    int (*_hash)(const TKey&);
+    int _count;
+    int _capacity;
+    double _p;
+    double _q;
+    Alloc _alloc;
+
+    // Хеш в индекс бакета
+    int bucket_index(const TKey& key) const {
+        int h = _hash(key);
+        return positive_mod(h, _capacity);
+    }
+
+    static bool equal_keys(const TKey& a, const TKey& b) {
+        // Требуется оператор== у ключа
+        return (a == b);
+    }
+
+    // Линейный поиск в бакете
+    static int index_in_bucket(const Bucket& bucket, const TKey& key) {
+        int n = bucket.GetLength();
+        KV* const* items = bucket.GetData();
+        for (int i = 0; i < n; ++i) {
+            if (equal_keys(items[i]->key, key)) return i;
+        }
+        return -1;
+    }
+
+    // Неудачный поиск ключа считается в трассировке как выход за границы
+    [[noreturn]] static void KeyNotFound(const char* message) {
+        LAB2_TRACE_EVENT(HashMap, BoundsFailures, 1);
+        throw std::out_of_range(message);
+    }
+
+    KV* new_node(const TKey& key, const TValue& v) {
+        LAB2_TRACE_EVENT(HashMap, Copies, 1); // выделение считает политика _alloc
+        void* mem = _alloc.Allocate(sizeof(KV));
+        try {
+            return new (mem) KV{ key, v };
+        } catch (...) {
+            _alloc.Deallocate(mem, sizeof(KV));
+            throw;
+        }
+    }
+
+    void free_node(KV* kv) {
+        kv->~KV();
+        _alloc.Deallocate(kv, sizeof(KV));
+    }
+
+    // Разрушает все записи и опустошает бакеты; арена откатывается целиком
+    void destroy_entries() {
+        int n = static_cast<int>(_buckets->GetSize());
+        for (int i = 0; i < n; ++i) {
+            Bucket& bucket = _buckets->GetRef(i);
+            const int m = bucket.GetLength();
+            for (int j = 0; j < m; ++j) {
+                KV* kv = bucket.Get(j);
+                if (!Alloc::kBulkRelease) free_node(kv);
+                else if (!std::is_trivially_destructible<KV>::value) kv->~KV();
+            }
+            bucket.Clear();
+        }
+        _alloc.Reset();
+    }
+
+    void insert_to_bucket(Bucket& bucket,
+                          const TKey& key,
+                          const TValue& v)
+    {
+        // Вставка в конец
+        KV* node = new_node(key, v);
+        try {
+            bucket.Append(node);
+        } catch (...) {
+            free_node(node);
+            throw;
+        }
+    }
+
+    void rehash(int newCapacity) {
+        if (newCapacity < 1) newCapacity = 1;
+
+        // Сохраняем старые бакеты
+        DynamicArray<Bucket>* old = _buckets;
+        int oldCap = _capacity;
+
+        // Создаем новые
+        _buckets = new DynamicArray<Bucket>(static_cast<size_t>(newCapacity));
+        _capacity = newCapacity;
+        LAB2_TRACE_EVENT(HashMap, Rehashes, 1);
+        LAB2_TRACE_EVENT(HashMap, Moves, _count);
+
+        // Пересыпаем (переносим указатели, записи не копируются)
+        for (int i = 0; i < oldCap; ++i) {
+            Bucket& bucket = old->GetRef(i);
+            int m = bucket.GetLength();
+            for (int j = 0; j < m; ++j) {
+                KV* kv = bucket.Get(j);
+                _buckets->GetRef(bucket_index(kv->key)).Append(kv);
+            }
+        }
+        delete old;
+
+        // _count не меняется
+    }
+};
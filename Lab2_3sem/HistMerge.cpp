@@ -0,0 +1,70 @@
+// Слияние частичных гистограмм (файлы MergeableHistogram) от разных шардов.
+// Сборка: g++ -std=c++17 -O2 -pthread HistMerge.cpp -o histmerge
+// Запуск: histmerge <out.hist> <in1.hist> [in2.hist ...]
+#include "MergeableHistogram.hpp"
+
+#include <fstream>
+#include <iostream>
+
+template <typename Key>
+static int MergeFiles(int argc, char** argv) {
+    MergeableHistogram<Key>* total = MergeableHistogram<Key>::LoadFromFile(argv[2]);
+    try {
+        for (int i = 3; i < argc; ++i) {
+            MergeableHistogram<Key>* part = nullptr;
+            try {
+                part = MergeableHistogram<Key>::LoadFromFile(argv[i]);
+                total->Merge(*part);
+            } catch (const std::exception& e) {
+                delete part;
+                throw std::runtime_error(std::string(argv[i]) + ": " + e.what());
+            }
+            delete part;
+        }
+        total->SaveToFile(argv[1]);
+
+        unsigned long long sum = 0;
+        for (int i = 0; i < total->GetBinCount(); ++i) sum += total->GetCount(i);
+        std::cout << "Merged " << (argc - 2) << " file(s): " << total->GetBinCount()
+                  << " bins, " << sum << " items -> " << argv[1] << "\n";
+    } catch (...) {
+        delete total;
+        throw;
+    }
+    delete total;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <out.hist> <in1.hist> [in2.hist ...]\n";
+        return 2;
+    }
+    try {
+        HistogramFileHeader h;
+        {
+            std::ifstream in(argv[2], std::ios::binary);
+            if (!in) throw std::runtime_error(std::string("cannot open ") + argv[2]);
+            h = ReadHistogramHeader(in);
+        }
+        // Тип ключа определяется по первому файлу; остальные обязаны совпадать
+        switch (h.keyKind) {
+        case KeySigned:
+            if (h.keySize == 4) return MergeFiles<int>(argc, argv);
+            if (h.keySize == 8) return MergeFiles<long long>(argc, argv);
+            break;
+        case KeyUnsigned:
+            if (h.keySize == 4) return MergeFiles<unsigned int>(argc, argv);
+            if (h.keySize == 8) return MergeFiles<unsigned long long>(argc, argv);
+            break;
+        case KeyFloat:
+            if (h.keySize == 4) return MergeFiles<float>(argc, argv);
+            if (h.keySize == 8) return MergeFiles<double>(argc, argv);
+            break;
+        }
+        throw std::runtime_error("unsupported key type in " + std::string(argv[2]));
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
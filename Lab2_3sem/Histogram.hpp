@@ -0,0 +1,190 @@
+#pragma once
+#include "HashMap.hpp"
+#include "Pipeline.hpp"
+
+#include <stdexcept>
+
+template <typename T>
+struct Range {
+    T lo; // inclusive
+    T hi; // exclusive
+    bool contains(const T& x) const {
+        // [lo, hi)
+        return !(x < lo) && (x < hi);
+    }
+    bool operator==(const Range& o) const {
+        return !(lo < o.lo) && !(o.lo < lo) && !(hi < o.hi) && !(o.hi < hi);
+    }
+};
+
+// Хеш для Range<T> (упрощённый; без STL)
+template <typename T>
+int HashRange(const Range<T>& r) {
+    // Требуется, чтобы у T были преобразования к целому (или перегрузка для double/int).
+    long long a = (long long)r.lo;
+    long long b = (long long)r.hi;
+    long long x = a * 1315423911LL ^ (b * 2654435761LL);
+    if (x < 0) x = -x;
+    return (int)(x & 0x7fffffff);
+}
+
+template <typename T, typename Key>
+struct HistogramParams {
+    Key minVal;
+    Key maxVal;
+    int binCount;
+    Key (*Projector)(const T&); // указатель на функцию-проектор
+};
+
+// Создание равномерных бинов
+template <typename Key>
+ArraySequence< Range<Key> >* MakeUniformBins(Key minVal, Key maxVal, int binCount) {
+    if (binCount <= 0) throw std::invalid_argument("binCount must be > 0");
+    if (!(minVal <= maxVal)) throw std::invalid_argument("minVal must be <= maxVal");
+
+    ArraySequence< Range<Key> >* bins = new ArraySequence< Range<Key> >();
+    // Ширина (для целых типов делим поровну, последний бин — до maxVal)
+    Key width = (Key)((maxVal - minVal) / (Key)binCount);
+    if (width <= (Key)0) width = (Key)1;
+
+    Key cur = minVal;
+    // first bin at slot 0
+    {
+        Key next = (binCount == 1) ? maxVal : (Key)(cur + width);
+        Range<Key> bin{ cur, next };
+        bins->SetAt(0, bin);                // use existing slot 0
+        cur = next;
+    }
+
+    // remaining bins
+    for (int i = 1; i < binCount; ++i) {
+        Key next = (i == binCount - 1) ? maxVal : (Key)(cur + width);
+        Range<Key> bin{ cur, next };
+        bins->Append(bin);
+        cur = next;
+    }
+    return bins;
+}
+
+// Поиск бина в сетке MakeUniformBins за O(1): индекс считается делением на
+// ширину, затем сверяется с границами (для чисел с плавающей точкой).
+// Возвращает тот же бин, что и линейный поиск первого bin.contains(value),
+// или -1, если такого нет.
+template <typename Key>
+class UniformBinLocator {
+private:
+    const Range<Key>* bins;
+    int binCount;
+    Key minVal;
+    Key width;
+
+public:
+    UniformBinLocator(const ArraySequence< Range<Key> >* bins, Key minVal, Key maxVal)
+    : bins(bins->GetData()), binCount((int)bins->GetLength()), minVal(minVal)
+    {
+        width = (Key)((maxVal - minVal) / (Key)binCount);
+        if (width <= (Key)0) width = (Key)1;
+    }
+
+    int operator()(const Key& value) const {
+        if (value < minVal) return -1;
+        Key offset = (Key)((value - minVal) / width);
+        int i = (offset < (Key)binCount) ? (int)offset : binCount - 1;
+        if (i < 0) i = 0;
+        while (i > 0 && value < bins[i].lo) --i;
+        while (i < binCount - 1 && !(value < bins[i].hi)) ++i;
+        return bins[i].contains(value) ? i : -1;
+    }
+};
+
+// Поиск бина двоичным поиском для бинов произвольной ширины,
+// упорядоченных по lo и не пересекающихся (например, MakeEquiDepthBins)
+template <typename Key>
+class SortedBinLocator {
+private:
+    const Range<Key>* bins;
+    int binCount;
+
+public:
+    explicit SortedBinLocator(const ArraySequence< Range<Key> >* bins)
+    : bins(bins->GetData()), binCount((int)bins->GetLength()) {}
+
+    int operator()(const Key& value) const {
+        // последний бин с lo <= value
+        int lo = 0, hi = binCount;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (value < bins[mid].lo) hi = mid;
+            else lo = mid + 1;
+        }
+        int i = lo - 1;
+        return (i >= 0 && bins[i].contains(value)) ? i : -1;
+    }
+};
+
+// Словарь-результат гистограммы из массива счётчиков (по одному на бин)
+template <typename Key>
+IDictionary< Range<Key>, int >*
+MakeHistogramDictionary(const ArraySequence< Range<Key> >* bins, const int* counts) {
+    int B = bins->GetLength();
+    // Словарь: ключ — Range<Key>, значение — int; записи живут в одной арене
+    HashMap< Range<Key>, int, ArenaAllocator >* dict =
+    new HashMap< Range<Key>, int, ArenaAllocator >(&HashRange<Key>, MaxT(25, B*2), 4.0, 2.0);
+    for (int i = 0; i < B; ++i) {
+        dict->Set(bins->Get(i), counts[i]);
+    }
+    return dict;
+}
+
+template <typename T, typename Key>
+IDictionary< Range<Key>, int >*
+BuildHistogram(ArraySequence<T>* seq, const HistogramParams<T,Key>& par) {
+    if (!par.Projector) throw std::invalid_argument("BuildHistogram: projector is null");
+    return BuildHistogram(seq, par, par.Projector);
+}
+
+// То же, но с проектором-функтором (лямбдой), который компилятор может встроить;
+// par.Projector при этом не используется
+template <typename T, typename Key, typename Proj>
+IDictionary< Range<Key>, int >*
+BuildHistogram(ArraySequence<T>* seq, const HistogramParams<T,Key>& par, Proj proj) {
+    if (!seq) throw std::invalid_argument("BuildHistogram: seq is null");
+    if (par.binCount <= 0) throw std::invalid_argument("BuildHistogram: binCount <= 0");
+
+    // Бины
+    ArraySequence< Range<Key> >* bins = MakeUniformBins<Key>(par.minVal, par.maxVal, par.binCount);
+    UniformBinLocator<Key> locate(bins, par.minVal, par.maxVal);
+
+    // Один проход: проекция -> индекс бина (без промежуточных последовательностей)
+    DynamicArray<int> counts(par.binCount);
+    int* c = counts.GetData();
+    for (int i = 0; i < par.binCount; ++i) c[i] = 0;
+    From(seq).Map(proj).ForEach([&](const Key& value) {
+        int j = locate(value);
+        if (j >= 0) ++c[j];
+    });
+
+    IDictionary< Range<Key>, int >* dict = MakeHistogramDictionary(bins, c);
+    delete bins;
+    return dict;
+}
+
+// Гистограмма по заданным бинам переменной ширины (отсортированным по lo)
+template <typename T, typename Key>
+IDictionary< Range<Key>, int >*
+BuildHistogramWithBins(ArraySequence<T>* seq, Key (*projector)(const T&), const ArraySequence< Range<Key> >* bins) {
+    if (!seq) throw std::invalid_argument("BuildHistogramWithBins: seq is null");
+    if (!projector) throw std::invalid_argument("BuildHistogramWithBins: projector is null");
+    if (!bins) throw std::invalid_argument("BuildHistogramWithBins: bins is null");
+
+    SortedBinLocator<Key> locate(bins);
+    int B = bins->GetLength();
+    DynamicArray<int> counts(B);
+    int* c = counts.GetData();
+    for (int i = 0; i < B; ++i) c[i] = 0;
+    From(seq).Map(projector).ForEach([&](const Key& value) {
+        int j = locate(value);
+        if (j >= 0) ++c[j];
+    });
+    return MakeHistogramDictionary(bins, c);
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include "Histogram.hpp"
+
+#include <cmath>
+#include <climits>
+
+// N-мерная (совместная) гистограмма с весами.
+// Каждая ось описывается как HistogramParams (minVal, maxVal, binCount,
+// Projector) и получает сетку MakeUniformBins. Веса всех ячеек лежат в одном
+// плоском массиве в порядке row-major: последняя ось меняется быстрее всего,
+// индекс ячейки = sum(bin[a] * strides[a]). Элемент, не попавший в бин хотя бы
+// по одной оси, не учитывается. Без Weight каждый элемент весит 1.
+// Ограничение: тип Key общий для всех осей. Для смешанных осей (возраст и
+// регион — целые, задержка — вещественная) проекторы приходится приводить к
+// общему типу, обычно double, и целые оси тогда бинируются в вещественной
+// арифметике. Совпадение 1-D результата с BuildHistogram гарантируется
+// только при том же Key.
+template <typename T, typename Key, int Dims>
+class HistogramND {
+    static_assert(Dims >= 1, "HistogramND: Dims must be >= 1");
+    template <typename, typename, int> friend class HistogramND;
+
+public:
+    HistogramND(const HistogramParams<T, Key> (&axes)[Dims], double (*weight)(const T&) = nullptr)
+    : weight(weight), cells(nullptr)
+    {
+        for (int a = 0; a < Dims; ++a) {
+            bins[a] = nullptr;
+            locators[a] = nullptr;
+        }
+        try {
+            for (int a = 0; a < Dims; ++a) SetAxis(a, axes[a]);
+            Allocate();
+        } catch (...) {
+            Release();
+            throw;
+        }
+    }
+
+    HistogramND(const HistogramND&) = delete;
+    HistogramND& operator=(const HistogramND&) = delete;
+
+    ~HistogramND() {
+        Release();
+    }
+
+    void Add(const T& item) {
+        size_t cell = 0;
+        for (int a = 0; a < Dims; ++a) {
+            int j = (*locators[a])(axes[a].Projector(item));
+            if (j < 0) return;
+            cell += (size_t)j * strides[a];
+        }
+        cells->GetData()[cell] += weight ? weight(item) : 1.0;
+    }
+
+    void AddAll(ArraySequence<T>* seq) {
+        if (!seq) throw std::invalid_argument("HistogramND: seq is null");
+        From(seq).ForEach([this](const T& item) { Add(item); });
+    }
+
+    void Clear() {
+        double* c = cells->GetData();
+        for (size_t i = 0; i < cellCount; ++i) c[i] = 0.0;
+    }
+
+    int GetBinCount(int axis) const {
+        CheckAxis(axis);
+        return axes[axis].binCount;
+    }
+
+    Range<Key> GetBin(int axis, int bin) const {
+        CheckAxis(axis);
+        return bins[axis]->Get(bin);
+    }
+
+    size_t GetCellCount() const { return cellCount; }
+    const double* GetCells() const { return cells->GetData(); }
+
+    double Get(const int (&index)[Dims]) const {
+        return cells->Get(CellOf(index));
+    }
+
+    double GetTotal() const {
+        double sum = 0.0;
+        const double* c = cells->GetData();
+        for (size_t i = 0; i < cellCount; ++i) sum += c[i];
+        return sum;
+    }
+
+    // Проекция на подмножество осей: веса по остальным осям суммируются.
+    // keep — номера оставляемых осей в нужном порядке
+    template <int M>
+    HistogramND<T, Key, M>* Project(const int (&keep)[M]) const {
+        HistogramParams<T, Key> sub[M];
+        for (int m = 0; m < M; ++m) {
+            CheckAxis(keep[m]);
+            for (int p = 0; p < m; ++p)
+                if (keep[p] == keep[m]) throw std::invalid_argument("HistogramND: axis listed twice");
+            sub[m] = axes[keep[m]];
+        }
+        HistogramND<T, Key, M>* result = new HistogramND<T, Key, M>(sub, weight);
+
+        // Обход всех ячеек с многомерным счётчиком
+        int index[Dims] = {};
+        const double* src = cells->GetData();
+        double* dst = result->cells->GetData();
+        for (size_t cell = 0; cell < cellCount; ++cell) {
+            size_t target = 0;
+            for (int m = 0; m < M; ++m)
+                target += (size_t)index[keep[m]] * result->strides[m];
+            dst[target] += src[cell];
+            for (int a = Dims - 1; a >= 0; --a) {
+                if (++index[a] < axes[a].binCount) break;
+                index[a] = 0;
+            }
+        }
+        return result;
+    }
+
+    // Маргинальное распределение по одной оси
+    HistogramND<T, Key, 1>* Marginal(int axis) const {
+        const int keep[1] = { axis };
+        return Project(keep);
+    }
+
+    // Только для Dims == 1: результат в виде BuildHistogram (веса округляются)
+    IDictionary< Range<Key>, int >* ToDictionary() const {
+        static_assert(Dims == 1, "HistogramND::ToDictionary is only defined for 1-D histograms");
+        DynamicArray<int> counts(axes[0].binCount);
+        const double* c = cells->GetData();
+        for (int i = 0; i < axes[0].binCount; ++i) {
+            double r = std::round(c[i]);
+            if (r > (double)INT_MAX || r < (double)INT_MIN) throw std::overflow_error("HistogramND: weight exceeds int");
+            counts.Set(i, (int)r);
+        }
+        return MakeHistogramDictionary(bins[0], counts.GetData());
+    }
+
+private:
+    HistogramParams<T, Key> axes[Dims];
+    ArraySequence< Range<Key> >* bins[Dims];
+    UniformBinLocator<Key>* locators[Dims];
+    size_t strides[Dims];
+    size_t cellCount;
+    double (*weight)(const T&);
+    DynamicArray<double>* cells;
+
+    void CheckAxis(int axis) const {
+        if (axis < 0 || axis >= Dims) throw std::out_of_range("HistogramND: axis out of range");
+    }
+
+    void SetAxis(int a, const HistogramParams<T, Key>& par) {
+        if (!par.Projector) throw std::invalid_argument("HistogramND: projector is null");
+        if (par.binCount <= 0) throw std::invalid_argument("HistogramND: binCount <= 0");
+        axes[a] = par;
+        bins[a] = MakeUniformBins<Key>(par.minVal, par.maxVal, par.binCount);
+        locators[a] = new UniformBinLocator<Key>(bins[a], par.minVal, par.maxVal);
+    }
+
+    void Allocate() {
+        cellCount = 1;
+        for (int a = Dims - 1; a >= 0; --a) {
+            strides[a] = cellCount;
+            if (cellCount > (size_t)-1 / (size_t)axes[a].binCount)
+                throw std::overflow_error("HistogramND: too many cells");
+            cellCount *= (size_t)axes[a].binCount;
+        }
+        cells = new DynamicArray<double>(cellCount);
+        Clear();
+    }
+
+    void Release() {
+        for (int a = 0; a < Dims; ++a) {
+            delete locators[a];
+            delete bins[a];
+            locators[a] = nullptr;
+            bins[a] = nullptr;
+        }
+        delete cells;
+        cells = nullptr;
+    }
+
+    size_t CellOf(const int (&index)[Dims]) const {
+        size_t cell = 0;
+        for (int a = 0; a < Dims; ++a) {
+            if (index[a] < 0 || index[a] >= axes[a].binCount) throw std::out_of_range("HistogramND: bin out of range");
+            cell += (size_t)index[a] * strides[a];
+        }
+        return cell;
+    }
+};
@@ -1,3 +1,4 @@
+#include "Trace.hpp"
 using namespace std;
 
 template <typename T> struct Node {
@@ -11,6 +12,18 @@ private:
     Node<T>* head;
     size_t length;
 
+    static Node<T>* NewNode(const T& item, Node<T>* next = nullptr) {
+        LAB2_TRACE_EVENT(LinkedList, Allocations, 1);
+        LAB2_TRACE_EVENT(LinkedList, AllocatedBytes, sizeof(Node<T>));
+        LAB2_TRACE_EVENT(LinkedList, Copies, 1);
+        return new Node<T>(item, next);
+    }
+
+    [[noreturn]] static void OutOfRange(const char* message) {
+        LAB2_TRACE_EVENT(LinkedList, BoundsFailures, 1);
+        throw out_of_range(message);
+    }
+
 public:
     LinkedList() : head(nullptr), length(0) {}
 
@@ -37,26 +50,26 @@ public:
     }
 
     T GetFirst() const {
-        if (!head) throw out_of_range("List is empty");
+        if (!head) OutOfRange("List is empty");
         return head->data;
     }
 
     T GetLast() const {
-        if (!head) throw out_of_range("List is empty");
+        if (!head) OutOfRange("List is empty");
         Node<T>* temp = head;
         while (temp->next) temp = temp->next;
         return temp->data;
     }
 
     T Get(size_t index) const {
-        if (index >= length) throw out_of_range("Index out of range");
+        if (index >= length) OutOfRange("Index out of range");
         Node<T>* temp = head;
         for (size_t i = 0; i < index; i++) temp = temp->next;
         return temp->data;
     }
 
     LinkedList<T>* GetSubList(size_t start, size_t end) const {
-        if (start > end || end >= length) throw out_of_range("Invalid sublist indices");
+        if (start > end || end >= length) OutOfRange("Invalid sublist indices");
         LinkedList<T>* sublist = new LinkedList<T>();
         Node<T>* temp = head;
         for (size_t i = 0; i <= end; i++) {
@@ -72,29 +85,29 @@ public:
 
     void Append(T item) {
         if (!head) {
-            head = new Node<T>(item);
+            head = NewNode(item);
         } else {
             Node<T>* temp = head;
             while (temp->next) temp = temp->next;
-            temp->next = new Node<T>(item);
+            temp->next = NewNode(item);
         }
         length++;
     }
 
     void Prepend(T item) {
-        head = new Node<T>(item, head);
+        head = NewNode(item, head);
         length++;
     }
 
     void InsertAt(T item, size_t index) {
-        if (index > length) throw out_of_range("Index out of range");
+        if (index > length) OutOfRange("Index out of range");
         if (index == 0) {
             Prepend(item);
             return;
         }
         Node<T>* temp = head;
         for (size_t i = 0; i < index - 1; i++) temp = temp->next;
-        temp->next = new Node<T>(item, temp->next);
+        temp->next = NewNode(item, temp->next);
         length++;
     }
 
@@ -107,4 +120,55 @@ public:
         }
         return result;
     }
+
+    // Естественная сортировка слиянием: сливает соседние возрастающие серии,
+    // перевязывая узлы без копирования данных. Устойчивая, O(n log r).
+    template <typename Cmp> void NaturalMergeSort(Cmp cmp) {
+        if (length < 2) return;
+        for (;;) {
+            Node<T>* rest = head;
+            Node<T>* sorted = nullptr;
+            Node<T>** tail = &sorted;
+            size_t merges = 0;
+            while (rest) {
+                Node<T>* a = TakeRun(rest, cmp);
+                Node<T>* b = rest ? TakeRun(rest, cmp) : nullptr;
+                *tail = MergeRuns(a, b, cmp);
+                while (*tail) tail = &(*tail)->next;
+                merges++;
+            }
+            head = sorted;
+            if (merges <= 1) return;
+        }
+    }
+
+private:
+    // Отрезает от rest неубывающую серию и возвращает её начало
+    template <typename Cmp> static Node<T>* TakeRun(Node<T>*& rest, Cmp& cmp) {
+        Node<T>* run = rest;
+        Node<T>* last = rest;
+        while (last->next && !cmp(last->next->data, last->data))
+            last = last->next;
+        rest = last->next;
+        last->next = nullptr;
+        return run;
+    }
+
+    template <typename Cmp> static Node<T>* MergeRuns(Node<T>* a, Node<T>* b, Cmp& cmp) {
+        Node<T>* merged = nullptr;
+        Node<T>** tail = &merged;
+        while (a && b) {
+            // при равенстве берём из a — сохраняет устойчивость
+            if (cmp(b->data, a->data)) {
+                *tail = b;
+                b = b->next;
+            } else {
+                *tail = a;
+                a = a->next;
+            }
+            tail = &(*tail)->next;
+        }
+        *tail = a ? a : b;
+        return merged;
+    }
 };
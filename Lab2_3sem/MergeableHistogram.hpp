@@ -0,0 +1,263 @@
+#pragma once
+#include "Histogram.hpp"
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Гистограмма, которую можно сохранить в компактный бинарный файл
+// и сложить с гистограммой другого шарда за O(бинов).
+//
+// Формат (little-endian), версия 1:
+//   char[4]  "LHST"
+//   u16      версия
+//   u8       вид ключа (0 — знаковое целое, 1 — беззнаковое, 2 — с плавающей точкой)
+//   u8       размер ключа в байтах
+//   u32      число бинов B
+//   Key      minVal, maxVal
+//   B × (Key lo, Key hi)  — границы бинов
+//   B × u64  счётчики
+enum HistogramKeyKind : uint8_t { KeySigned = 0, KeyUnsigned = 1, KeyFloat = 2 };
+
+struct HistogramFileHeader {
+    uint16_t version;
+    uint8_t keyKind;
+    uint8_t keySize;
+    uint32_t binCount;
+};
+
+const uint16_t kHistogramFormatVersion = 1;
+
+namespace histogram_io {
+    inline void WriteLE(std::ostream& out, uint64_t value, size_t bytes) {
+        char buf[8];
+        for (size_t i = 0; i < bytes; i++) buf[i] = (char)((value >> (8 * i)) & 0xFF);
+        out.write(buf, (std::streamsize)bytes);
+    }
+
+    inline uint64_t ReadLE(std::istream& in, size_t bytes) {
+        unsigned char buf[8];
+        if (!in.read(reinterpret_cast<char*>(buf), (std::streamsize)bytes))
+            throw std::runtime_error("Histogram file: unexpected end of data");
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes; i++) value |= (uint64_t)buf[i] << (8 * i);
+        return value;
+    }
+
+    // Число бинов, которое читается из потока без seek (там длину не проверить)
+    const uint32_t kMaxUnseekableBins = 1u << 20;
+
+    // Проверяет до выделения памяти, что в потоке есть ещё bytes байт.
+    // Для потоков без seek (pipe) ограничивается потолком числа бинов.
+    inline void RequirePayload(std::istream& in, uint64_t bytes, uint32_t binCount) {
+        std::streampos pos = in.tellg();
+        if (pos != std::streampos(-1) && in.seekg(0, std::ios::end)) {
+            std::streampos end = in.tellg();
+            in.seekg(pos);
+            if (end == std::streampos(-1) || !in) throw std::runtime_error("Histogram file: cannot determine size");
+            if ((uint64_t)(end - pos) < bytes) throw std::runtime_error("Histogram file: truncated");
+            return;
+        }
+        in.clear();
+        if (binCount > kMaxUnseekableBins) throw std::runtime_error("Histogram file: too many bins");
+    }
+
+    template <typename Key> uint8_t KindOf() {
+        return std::is_floating_point<Key>::value ? KeyFloat
+             : std::is_signed<Key>::value ? KeySigned : KeyUnsigned;
+    }
+
+    template <typename Key> void WriteKey(std::ostream& out, Key key) {
+        static_assert(sizeof(Key) <= 8, "Histogram file: key wider than 64 bits");
+        uint64_t bits = 0;
+        if (std::is_floating_point<Key>::value) {
+            std::memcpy(&bits, &key, sizeof(Key));
+        } else {
+            bits = (uint64_t)key;
+        }
+        WriteLE(out, bits, sizeof(Key));
+    }
+
+    template <typename Key> Key ReadKey(std::istream& in) {
+        uint64_t bits = ReadLE(in, sizeof(Key));
+        Key key;
+        if (std::is_floating_point<Key>::value) {
+            std::memcpy(&key, &bits, sizeof(Key));
+        } else {
+            key = (Key)bits;
+        }
+        return key;
+    }
+}
+
+// Читает только заголовок — чтобы выбрать тип ключа до загрузки
+inline HistogramFileHeader ReadHistogramHeader(std::istream& in) {
+    char magic[4];
+    if (!in.read(magic, 4) || std::memcmp(magic, "LHST", 4) != 0)
+        throw std::runtime_error("Histogram file: bad magic");
+    HistogramFileHeader h;
+    h.version = (uint16_t)histogram_io::ReadLE(in, 2);
+    if (h.version == 0 || h.version > kHistogramFormatVersion)
+        throw std::runtime_error("Histogram file: unsupported version " + std::to_string(h.version));
+    h.keyKind = (uint8_t)histogram_io::ReadLE(in, 1);
+    h.keySize = (uint8_t)histogram_io::ReadLE(in, 1);
+    h.binCount = (uint32_t)histogram_io::ReadLE(in, 4);
+    if (h.binCount == 0) throw std::runtime_error("Histogram file: zero bins");
+    return h;
+}
+
+template <typename Key>
+class MergeableHistogram {
+private:
+    Key minVal;
+    Key maxVal;
+    int binCount;
+    DynamicArray< Range<Key> > bins;
+    DynamicArray<unsigned long long> counts;
+
+    // Раскладка задана явно (используется при чтении из файла)
+    MergeableHistogram(Key minVal, Key maxVal, int binCount, bool)
+    : minVal(minVal), maxVal(maxVal), binCount(binCount), bins(binCount), counts(binCount) {}
+
+public:
+    // Пустая гистограмма с раскладкой MakeUniformBins
+    MergeableHistogram(Key minVal, Key maxVal, int binCount)
+    : minVal(minVal), maxVal(maxVal), binCount(binCount),
+      bins(binCount > 0 ? binCount : 1), counts(binCount > 0 ? binCount : 1)
+    {
+        ArraySequence< Range<Key> >* uniform = MakeUniformBins<Key>(minVal, maxVal, binCount);
+        for (int i = 0; i < binCount; ++i) {
+            bins.Set(i, uniform->Get(i));
+            counts.Set(i, 0);
+        }
+        delete uniform;
+    }
+
+    MergeableHistogram(const MergeableHistogram& other) = default;
+    MergeableHistogram& operator=(const MergeableHistogram&) = delete;
+
+    template <typename T>
+    static MergeableHistogram* Build(ArraySequence<T>* seq, const HistogramParams<T, Key>& par) {
+        if (!seq) throw std::invalid_argument("MergeableHistogram: seq is null");
+        if (!par.Projector) throw std::invalid_argument("MergeableHistogram: projector is null");
+        MergeableHistogram* h = new MergeableHistogram(par.minVal, par.maxVal, par.binCount);
+        ArraySequence< Range<Key> >* uniform = MakeUniformBins<Key>(par.minVal, par.maxVal, par.binCount);
+        UniformBinLocator<Key> locate(uniform, par.minVal, par.maxVal);
+        unsigned long long* c = h->counts.GetData();
+        From(seq).Map(par.Projector).ForEach([&](const Key& value) {
+            int j = locate(value);
+            if (j >= 0) ++c[j];
+        });
+        delete uniform;
+        return h;
+    }
+
+    // Из результата BuildHistogram с теми же параметрами
+    static MergeableHistogram* FromDictionary(IDictionary< Range<Key>, int >* dict,
+                                              Key minVal, Key maxVal, int binCount)
+    {
+        if (!dict) throw std::invalid_argument("MergeableHistogram: dict is null");
+        MergeableHistogram* h = new MergeableHistogram(minVal, maxVal, binCount);
+        for (int i = 0; i < binCount; ++i) {
+            Range<Key> bin = h->bins.Get(i);
+            if (dict->ContainsKey(bin)) h->counts.Set(i, (unsigned long long)dict->Get(bin));
+        }
+        return h;
+    }
+
+    Key GetMin() const { return minVal; }
+    Key GetMax() const { return maxVal; }
+    int GetBinCount() const { return binCount; }
+    Range<Key> GetBin(int i) const { return bins.Get(i); }
+    unsigned long long GetCount(int i) const { return counts.Get(i); }
+
+    bool IsCompatible(const MergeableHistogram& other) const {
+        if (binCount != other.binCount) return false;
+        if (!(Range<Key>{ minVal, maxVal } == Range<Key>{ other.minVal, other.maxVal })) return false;
+        const Range<Key>* a = bins.GetData();
+        const Range<Key>* b = other.bins.GetData();
+        for (int i = 0; i < binCount; ++i)
+            if (!(a[i] == b[i])) return false;
+        return true;
+    }
+
+    // Поэлементная сумма счётчиков; раскладки должны совпадать
+    void Merge(const MergeableHistogram& other) {
+        if (!IsCompatible(other)) throw std::invalid_argument("MergeableHistogram: incompatible bin layouts");
+        unsigned long long* c = counts.GetData();
+        const unsigned long long* o = other.counts.GetData();
+        for (int i = 0; i < binCount; ++i) c[i] += o[i];
+    }
+
+    IDictionary< Range<Key>, int >* ToDictionary() const {
+        DynamicArray<int> narrow(binCount);
+        for (int i = 0; i < binCount; ++i) {
+            unsigned long long c = counts.Get(i);
+            if (c > (unsigned long long)INT_MAX) throw std::overflow_error("MergeableHistogram: count exceeds int");
+            narrow.Set(i, (int)c);
+        }
+        ArraySequence< Range<Key> > seq(bins);
+        return MakeHistogramDictionary(&seq, narrow.GetData());
+    }
+
+    void Write(std::ostream& out) const {
+        out.write("LHST", 4);
+        histogram_io::WriteLE(out, kHistogramFormatVersion, 2);
+        histogram_io::WriteLE(out, histogram_io::KindOf<Key>(), 1);
+        histogram_io::WriteLE(out, sizeof(Key), 1);
+        histogram_io::WriteLE(out, (uint64_t)binCount, 4);
+        histogram_io::WriteKey(out, minVal);
+        histogram_io::WriteKey(out, maxVal);
+        for (int i = 0; i < binCount; ++i) {
+            Range<Key> bin = bins.Get(i);
+            histogram_io::WriteKey(out, bin.lo);
+            histogram_io::WriteKey(out, bin.hi);
+        }
+        for (int i = 0; i < binCount; ++i)
+            histogram_io::WriteLE(out, counts.Get(i), 8);
+        if (!out) throw std::runtime_error("Histogram file: write failed");
+    }
+
+    static MergeableHistogram* Read(std::istream& in) {
+        HistogramFileHeader h = ReadHistogramHeader(in);
+        if (h.keyKind != histogram_io::KindOf<Key>() || h.keySize != sizeof(Key))
+            throw std::runtime_error("Histogram file: key type mismatch");
+        if (h.binCount > (uint32_t)INT_MAX) throw std::runtime_error("Histogram file: too many bins");
+        // minVal, maxVal, B пар границ и B счётчиков — проверяем до выделения памяти
+        histogram_io::RequirePayload(in, 2 * sizeof(Key) + (uint64_t)h.binCount * (2 * sizeof(Key) + 8), h.binCount);
+        Key lo = histogram_io::ReadKey<Key>(in);
+        Key hi = histogram_io::ReadKey<Key>(in);
+        MergeableHistogram* result = new MergeableHistogram(lo, hi, (int)h.binCount, true);
+        try {
+            for (int i = 0; i < result->binCount; ++i) {
+                Key a = histogram_io::ReadKey<Key>(in);
+                Key b = histogram_io::ReadKey<Key>(in);
+                result->bins.Set(i, Range<Key>{ a, b });
+            }
+            for (int i = 0; i < result->binCount; ++i)
+                result->counts.Set(i, histogram_io::ReadLE(in, 8));
+        } catch (...) {
+            delete result;
+            throw;
+        }
+        return result;
+    }
+
+    void SaveToFile(const std::string& path) const {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        if (!out) throw std::runtime_error("Histogram file: cannot open " + path);
+        Write(out);
+    }
+
+    static MergeableHistogram* LoadFromFile(const std::string& path) {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        if (!in) throw std::runtime_error("Histogram file: cannot open " + path);
+        return Read(in);
+    }
+};
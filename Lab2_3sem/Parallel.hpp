@@ -0,0 +1,115 @@
+#pragma once
+#include "Sequence.hpp"
+#include "ThreadPool.hpp"
+
+#include <type_traits>
+#include <utility>
+
+// Параллельные ForEach / Transform / Map / Reduce над DynamicArray и ArraySequence.
+// Работа делится на куски ParallelFor / ParallelReduceChunks (ThreadPool.hpp);
+// пул по умолчанию — ThreadPool::Default().
+
+// fn(T&) для каждого элемента
+template <typename T, typename F>
+void ParallelForEach(DynamicArray<T>& arr, F fn, ThreadPool& pool = ThreadPool::Default()) {
+    T* data = arr.GetData();
+    ParallelFor(pool, arr.GetSize(), [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; i++) fn(data[i]);
+    });
+}
+
+template <typename T, typename F>
+void ParallelForEach(ArraySequence<T>& seq, F fn, ThreadPool& pool = ThreadPool::Default()) {
+    T* data = seq.GetData();
+    ParallelFor(pool, seq.GetLength(), [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; i++) fn(data[i]);
+    });
+}
+
+// dst[i] = fn(src[i]); dst должен быть не короче src
+template <typename T, typename U, typename F>
+void ParallelTransform(const DynamicArray<T>& src, DynamicArray<U>& dst, F fn,
+                       ThreadPool& pool = ThreadPool::Default())
+{
+    if (dst.GetSize() < src.GetSize()) throw invalid_argument("ParallelTransform: destination too short");
+    const T* in = src.GetData();
+    U* out = dst.GetData();
+    ParallelFor(pool, src.GetSize(), [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; i++) out[i] = fn(in[i]);
+    });
+}
+
+template <typename T, typename U, typename F>
+void ParallelTransform(const ArraySequence<T>& src, ArraySequence<U>& dst, F fn,
+                       ThreadPool& pool = ThreadPool::Default())
+{
+    if (dst.GetLength() < src.GetLength()) throw invalid_argument("ParallelTransform: destination too short");
+    const T* in = src.GetData();
+    U* out = dst.GetData();
+    ParallelFor(pool, src.GetLength(), [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; i++) out[i] = fn(in[i]);
+    });
+}
+
+// Новая последовательность из fn(src[i])
+template <typename T, typename F>
+ArraySequence< typename std::decay<decltype(std::declval<F&>()(std::declval<const T&>()))>::type >*
+ParallelMap(const ArraySequence<T>& src, F fn, ThreadPool& pool = ThreadPool::Default()) {
+    typedef typename std::decay<decltype(std::declval<F&>()(std::declval<const T&>()))>::type U;
+    size_t n = src.GetLength();
+    if (n == 0) return new ArraySequence<U>((const U*)nullptr, 0);
+    ArraySequence<U>* result = new ArraySequence<U>(DynamicArray<U>(n));
+    const T* in = src.GetData();
+    U* out = result->GetData();
+    try {
+        ParallelFor(pool, n, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; i++) out[i] = fn(in[i]);
+        });
+    } catch (...) {
+        delete result;
+        throw;
+    }
+    return result;
+}
+
+// Свёртка fold(acc, item) внутри куска и combine(acc, acc) между кусками.
+// Куски сворачиваются слева направо, поэтому результат детерминирован;
+// ReduceOrder::Pinned дополнительно делает его независимым от числа потоков.
+template <typename T, typename Acc, typename Fold, typename Combine>
+Acc ParallelReduce(const DynamicArray<T>& arr, Acc identity, Fold fold, Combine combine,
+                   ReduceOrder order = ReduceOrder::Pinned,
+                   ThreadPool& pool = ThreadPool::Default())
+{
+    const T* data = arr.GetData();
+    return ParallelReduceChunks(pool, arr.GetSize(), identity,
+        [&](size_t lo, size_t hi) {
+            Acc part = identity;
+            for (size_t i = lo; i < hi; i++) part = fold(part, data[i]);
+            return part;
+        },
+        combine, order);
+}
+
+template <typename T, typename Acc, typename Fold, typename Combine>
+Acc ParallelReduce(const ArraySequence<T>& seq, Acc identity, Fold fold, Combine combine,
+                   ReduceOrder order = ReduceOrder::Pinned,
+                   ThreadPool& pool = ThreadPool::Default())
+{
+    const T* data = seq.GetData();
+    return ParallelReduceChunks(pool, seq.GetLength(), identity,
+        [&](size_t lo, size_t hi) {
+            Acc part = identity;
+            for (size_t i = lo; i < hi; i++) part = fold(part, data[i]);
+            return part;
+        },
+        combine, order);
+}
+
+// Упрощённая форма для ассоциативной операции над T (сумма, максимум и т.п.)
+template <typename T, typename Op>
+T ParallelReduce(const ArraySequence<T>& seq, T identity, Op op,
+                 ReduceOrder order = ReduceOrder::Pinned,
+                 ThreadPool& pool = ThreadPool::Default())
+{
+    return ParallelReduce(seq, identity, op, op, order, pool);
+}
@@ -0,0 +1,268 @@
+#pragma once
+#include "Sequence.hpp"
+
+#include <type_traits>
+#include <utility>
+
+// Ленивый конвейер над Sequence<T>.
+// Каждая стадия — шаблон с методом Next(), который возвращает указатель на
+// текущий элемент или nullptr в конце. Стадии вкладываются друг в друга по
+// значению, поэтому весь конвейер разворачивается компилятором в один цикл
+// без промежуточных Sequence и без виртуальных вызовов на элемент
+// (кроме SequenceSource для произвольной Sequence<T>).
+
+// Источник поверх непрерывного буфера (ArraySequence / DynamicArray)
+template <typename T> class BufferSource {
+private:
+    const T* data;
+    size_t index;
+    size_t length;
+
+public:
+    typedef T value_type;
+
+    BufferSource(const T* data, size_t length) : data(data), index(0), length(length) {}
+
+    const T* Next() {
+        if (index >= length) return nullptr;
+        return &data[index++];
+    }
+};
+
+// Источник поверх произвольной Sequence<T> (виртуальный Get)
+template <typename T> class SequenceSource {
+private:
+    const Sequence<T>* seq;
+    size_t index;
+    size_t length;
+    T current;
+
+public:
+    typedef T value_type;
+
+    SequenceSource(const Sequence<T>* seq) : seq(seq), index(0), length(seq->GetLength()), current() {}
+
+    const T* Next() {
+        if (index >= length) return nullptr;
+        current = seq->Get(index++);
+        return &current;
+    }
+};
+
+template <typename Src, typename F> class MapStage {
+public:
+    typedef typename std::decay<
+        decltype(std::declval<F&>()(std::declval<const typename Src::value_type&>()))
+    >::type value_type;
+
+private:
+    Src src;
+    F fn;
+    value_type current;
+
+public:
+    MapStage(const Src& src, F fn) : src(src), fn(fn), current() {}
+
+    const value_type* Next() {
+        const typename Src::value_type* item = src.Next();
+        if (!item) return nullptr;
+        current = fn(*item);
+        return &current;
+    }
+};
+
+template <typename Src, typename P> class WhereStage {
+private:
+    Src src;
+    P pred;
+
+public:
+    typedef typename Src::value_type value_type;
+
+    WhereStage(const Src& src, P pred) : src(src), pred(pred) {}
+
+    const value_type* Next() {
+        const value_type* item;
+        while ((item = src.Next()) != nullptr) {
+            if (pred(*item)) return item;
+        }
+        return nullptr;
+    }
+};
+
+template <typename SrcA, typename SrcB> class ZipStage {
+public:
+    typedef std::pair<typename SrcA::value_type, typename SrcB::value_type> value_type;
+
+private:
+    SrcA a;
+    SrcB b;
+    value_type current;
+
+public:
+    ZipStage(const SrcA& a, const SrcB& b) : a(a), b(b), current() {}
+
+    // Заканчивается вместе с более короткой из двух последовательностей
+    const value_type* Next() {
+        const typename SrcA::value_type* x = a.Next();
+        if (!x) return nullptr;
+        const typename SrcB::value_type* y = b.Next();
+        if (!y) return nullptr;
+        current.first = *x;
+        current.second = *y;
+        return &current;
+    }
+};
+
+template <typename Src> class TakeStage {
+private:
+    Src src;
+    size_t left;
+
+public:
+    typedef typename Src::value_type value_type;
+
+    TakeStage(const Src& src, size_t count) : src(src), left(count) {}
+
+    const value_type* Next() {
+        if (left == 0) return nullptr;
+        --left;
+        return src.Next();
+    }
+};
+
+template <typename Src> class SkipStage {
+private:
+    Src src;
+    size_t skip;
+
+public:
+    typedef typename Src::value_type value_type;
+
+    SkipStage(const Src& src, size_t count) : src(src), skip(count) {}
+
+    const value_type* Next() {
+        while (skip > 0) {
+            --skip;
+            if (!src.Next()) return nullptr;
+        }
+        return src.Next();
+    }
+};
+
+template <typename Stage> class Pipeline {
+private:
+    Stage stage;
+
+public:
+    typedef typename Stage::value_type value_type;
+
+    explicit Pipeline(const Stage& stage) : stage(stage) {}
+
+    template <typename F>
+    Pipeline< MapStage<Stage, F> > Map(F fn) const {
+        return Pipeline< MapStage<Stage, F> >(MapStage<Stage, F>(stage, fn));
+    }
+
+    template <typename P>
+    Pipeline< WhereStage<Stage, P> > Where(P pred) const {
+        return Pipeline< WhereStage<Stage, P> >(WhereStage<Stage, P>(stage, pred));
+    }
+
+    template <typename Other>
+    Pipeline< ZipStage<Stage, Other> > Zip(const Pipeline<Other>& other) const {
+        return Pipeline< ZipStage<Stage, Other> >(ZipStage<Stage, Other>(stage, other.GetStage()));
+    }
+
+    Pipeline< TakeStage<Stage> > Take(size_t count) const {
+        return Pipeline< TakeStage<Stage> >(TakeStage<Stage>(stage, count));
+    }
+
+    Pipeline< SkipStage<Stage> > Skip(size_t count) const {
+        return Pipeline< SkipStage<Stage> >(SkipStage<Stage>(stage, count));
+    }
+
+    // Терминальные операции: один проход по источнику
+
+    template <typename Acc, typename F>
+    Acc Reduce(Acc init, F fn) const {
+        Stage s = stage;
+        const value_type* item;
+        while ((item = s.Next()) != nullptr)
+            init = fn(init, *item);
+        return init;
+    }
+
+    template <typename F>
+    void ForEach(F fn) const {
+        Stage s = stage;
+        const value_type* item;
+        while ((item = s.Next()) != nullptr)
+            fn(*item);
+    }
+
+    size_t Count() const {
+        Stage s = stage;
+        size_t n = 0;
+        while (s.Next()) ++n;
+        return n;
+    }
+
+    // Материализация результата (единственная аллокация — буфер результата)
+    ArraySequence<value_type>* ToArraySequence() const {
+        Stage s = stage;
+        size_t capacity = 16;
+        size_t n = 0;
+        value_type* buffer = new value_type[capacity];
+        const value_type* item;
+        try {
+            while ((item = s.Next()) != nullptr) {
+                if (n == capacity) {
+                    value_type* grown = new value_type[capacity * 2];
+                    for (size_t i = 0; i < n; i++) grown[i] = buffer[i];
+                    delete[] buffer;
+                    buffer = grown;
+                    capacity *= 2;
+                }
+                buffer[n++] = *item;
+            }
+        } catch (...) {
+            delete[] buffer;
+            throw;
+        }
+        auto* result = new ArraySequence<value_type>(buffer, n);
+        delete[] buffer;
+        return result;
+    }
+
+    const Stage& GetStage() const {
+        return stage;
+    }
+};
+
+template <typename T>
+Pipeline< BufferSource<T> > From(const ArraySequence<T>* seq) {
+    if (!seq) throw invalid_argument("From: seq is null");
+    return Pipeline< BufferSource<T> >(BufferSource<T>(seq->GetData(), seq->GetLength()));
+}
+
+template <typename T>
+Pipeline< BufferSource<T> > From(const ArraySequence<T>& seq) {
+    return From(&seq);
+}
+
+template <typename T>
+Pipeline< BufferSource<T> > From(const DynamicArray<T>& arr) {
+    return Pipeline< BufferSource<T> >(BufferSource<T>(arr.GetData(), arr.GetSize()));
+}
+
+template <typename T>
+Pipeline< SequenceSource<T> > From(const Sequence<T>* seq) {
+    if (!seq) throw invalid_argument("From: seq is null");
+    return Pipeline< SequenceSource<T> >(SequenceSource<T>(seq));
+}
+
+template <typename T>
+Pipeline< SequenceSource<T> > From(const Sequence<T>& seq) {
+    return From(&seq);
+}
@@ -0,0 +1,339 @@
+#pragma once
+#include "Histogram.hpp"
+#include "Sort.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// Потоковый скетч квантилей в духе KLL.
+// Уровень h хранит элементы веса 2^h. Когда скетч переполняется, самый нижний
+// полный уровень сортируется, и каждый второй его элемент (со случайным
+// сдвигом) поднимается на уровень выше. Ёмкость уровней убывает вниз
+// геометрически (k, 2k/3, 4k/9, ...), поэтому память — O(k) при любом n,
+// а ошибка ранга — порядка n / k. Скетчи с одинаковым k можно сливать.
+template <typename Key>
+class QuantileSketch {
+public:
+    explicit QuantileSketch(int k = 200, uint64_t seed = 0x9E3779B97F4A7C15ULL)
+    : k(k), levelCount(1), count(0), minVal(), maxVal(), rng(seed ? seed : 1),
+      view(nullptr), viewSize(0)
+    {
+        if (k < 8) throw std::invalid_argument("QuantileSketch: k must be >= 8");
+        for (int h = 0; h < kMaxLevels; h++) {
+            levels[h] = nullptr;
+            sizes[h] = 0;
+        }
+        RecomputeCapacities();
+    }
+
+    QuantileSketch(const QuantileSketch&) = delete;
+    QuantileSketch& operator=(const QuantileSketch&) = delete;
+
+    ~QuantileSketch() {
+        for (int h = 0; h < kMaxLevels; h++) delete levels[h];
+        delete view;
+    }
+
+    void Update(const Key& value) {
+        if (count == 0 || value < minVal) minVal = value;
+        if (count == 0 || maxVal < value) maxVal = value;
+        Push(0, value);
+        count++;
+        InvalidateView();
+        if (sizes[0] >= Capacity(0)) Compress();
+    }
+
+    // Сливает other в этот скетч; other не меняется. Допустимо и s.Merge(s)
+    void Merge(const QuantileSketch& other) {
+        if (other.k != k) throw std::invalid_argument("QuantileSketch: cannot merge sketches with different k");
+        if (other.count == 0) return;
+        // при слиянии с собой Push дописывает в те же уровни, поэтому
+        // размеры фиксируются заранее, а элементы читаются по индексу
+        size_t otherSizes[kMaxLevels];
+        int otherLevels = other.levelCount;
+        unsigned long long otherCount = other.count;
+        for (int h = 0; h < otherLevels; h++) otherSizes[h] = other.sizes[h];
+        if (count == 0 || other.minVal < minVal) minVal = other.minVal;
+        if (count == 0 || maxVal < other.maxVal) maxVal = other.maxVal;
+        if (levelCount < otherLevels) {
+            levelCount = otherLevels;
+            RecomputeCapacities();
+        }
+        for (int h = 0; h < otherLevels; h++)
+            for (size_t i = 0; i < otherSizes[h]; i++)
+                Push(h, other.levels[h]->GetData()[i]);
+        count += otherCount;
+        InvalidateView();
+        Compress();
+    }
+
+    unsigned long long GetCount() const { return count; }
+    int GetK() const { return k; }
+
+    Key GetMin() const {
+        if (count == 0) throw std::out_of_range("QuantileSketch is empty");
+        return minVal;
+    }
+
+    Key GetMax() const {
+        if (count == 0) throw std::out_of_range("QuantileSketch is empty");
+        return maxVal;
+    }
+
+    // Число сохранённых элементов (память скетча)
+    size_t GetRetained() const {
+        size_t total = 0;
+        for (int h = 0; h < levelCount; h++) total += sizes[h];
+        return total;
+    }
+
+    // Приближённое значение q-квантиля, q в [0, 1]
+    Key Quantile(double q) const {
+        if (count == 0) throw std::out_of_range("QuantileSketch is empty");
+        if (!(q >= 0.0 && q <= 1.0)) throw std::invalid_argument("QuantileSketch: q must be in [0, 1]");
+        if (q == 0.0) return minVal;
+        if (q == 1.0) return maxVal;
+        BuildView();
+        const WeightedItem* items = view->GetData();
+        double target = q * (double)count;
+        unsigned long long cumulative = 0;
+        for (size_t i = 0; i < viewSize; i++) {
+            cumulative += items[i].weight;
+            if ((double)cumulative >= target) return items[i].value;
+        }
+        return maxVal;
+    }
+
+    // Приближённое число элементов строго меньше value
+    unsigned long long Rank(const Key& value) const {
+        if (count == 0) return 0;
+        BuildView();
+        const WeightedItem* items = view->GetData();
+        // первый элемент, не меньший value
+        size_t lo = 0, hi = viewSize;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (items[mid].value < value) lo = mid + 1;
+            else hi = mid;
+        }
+        return (lo == 0) ? 0 : items[lo - 1].cumulative;
+    }
+
+private:
+    static const int kMaxLevels = 64;
+
+    struct WeightedItem {
+        Key value;
+        unsigned long long weight;
+        unsigned long long cumulative;
+    };
+
+    struct ByValue {
+        bool operator()(const WeightedItem& a, const WeightedItem& b) const { return a.value < b.value; }
+    };
+
+    int k;
+    int levelCount;
+    unsigned long long count;
+    Key minVal;
+    Key maxVal;
+    uint64_t rng;
+    DynamicArray<Key>* levels[kMaxLevels];
+    size_t sizes[kMaxLevels];
+    size_t capacities[kMaxLevels];
+
+    // Отсортированный взвешенный срез для запросов; перестраивается лениво
+    mutable DynamicArray<WeightedItem>* view;
+    mutable size_t viewSize;
+
+    // Ёмкости зависят от числа уровней; пересчитываются при его изменении
+    void RecomputeCapacities() {
+        for (int h = 0; h < levelCount; h++) {
+            double c = std::ceil(k * std::pow(2.0 / 3.0, levelCount - 1 - h));
+            capacities[h] = (c < 2.0) ? 2 : (size_t)c;
+        }
+    }
+
+    size_t Capacity(int h) const {
+        return capacities[h];
+    }
+
+    size_t TotalCapacity() const {
+        size_t total = 0;
+        for (int h = 0; h < levelCount; h++) total += capacities[h];
+        return total;
+    }
+
+    // value по значению: Resize может освободить буфер, на который указывала бы ссылка
+    void Push(int h, Key value) {
+        if (!levels[h]) {
+            levels[h] = new DynamicArray<Key>(Capacity(h) + 1);
+        } else if (sizes[h] == levels[h]->GetSize()) {
+            levels[h]->Resize(sizes[h] * 2);
+        }
+        levels[h]->GetData()[sizes[h]++] = value;
+    }
+
+    bool NextBit() {
+        // xorshift64
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        return (rng & 1) != 0;
+    }
+
+    void CompactLevel(int h) {
+        if (h + 1 >= kMaxLevels) throw std::overflow_error("QuantileSketch: too many levels");
+        if (h + 1 == levelCount) {
+            levelCount++;
+            RecomputeCapacities();
+        }
+        Key* items = levels[h]->GetData();
+        size_t n = sizes[h];
+        IntroSort(items, n);
+        // при нечётном числе самый маленький элемент остаётся на уровне
+        size_t start = (n % 2 == 1) ? 1 : 0;
+        for (size_t i = start + (NextBit() ? 1 : 0); i < n; i += 2)
+            Push(h + 1, items[i]);
+        sizes[h] = start;
+    }
+
+    void Compress() {
+        while (GetRetained() > TotalCapacity()) {
+            int h = 0;
+            while (h < levelCount && sizes[h] < Capacity(h)) h++;
+            if (h == levelCount) return;
+            CompactLevel(h);
+        }
+        // нижний уровень не должен переполняться при следующем Update
+        while (sizes[0] >= Capacity(0)) CompactLevel(0);
+    }
+
+    void InvalidateView() {
+        viewSize = 0;
+    }
+
+    void BuildView() const {
+        if (viewSize > 0) return;
+        size_t total = GetRetained();
+        if (!view || view->GetSize() < total) {
+            delete view;
+            view = nullptr;
+            view = new DynamicArray<WeightedItem>(total);
+        }
+        WeightedItem* items = view->GetData();
+        size_t n = 0;
+        for (int h = 0; h < levelCount; h++)
+            for (size_t i = 0; i < sizes[h]; i++)
+                items[n++] = WeightedItem{ levels[h]->GetData()[i], 1ULL << h, 0 };
+        IntroSort(items, n, ByValue());
+        unsigned long long cumulative = 0;
+        for (size_t i = 0; i < n; i++) {
+            cumulative += items[i].weight;
+            items[i].cumulative = cumulative;
+        }
+        viewSize = n;
+    }
+};
+
+namespace quantile_detail {
+    // Наименьшее значение, строго большее value (для верхней границы последнего бина)
+    template <typename Key>
+    typename std::enable_if<std::is_floating_point<Key>::value, Key>::type NextAbove(Key value) {
+        return std::nextafter(value, std::numeric_limits<Key>::infinity());
+    }
+
+    template <typename Key>
+    typename std::enable_if<!std::is_floating_point<Key>::value, Key>::type NextAbove(Key value) {
+        return (value < std::numeric_limits<Key>::max()) ? (Key)(value + 1) : value;
+    }
+}
+
+// Равноглубинные бины: границы — квантили i / binCount из скетча.
+// Совпадающие квантили (много одинаковых значений) склеиваются, поэтому
+// бинов может получиться меньше, чем запрошено. Последний бин включает максимум.
+template <typename Key>
+ArraySequence< Range<Key> >* MakeEquiDepthBins(const QuantileSketch<Key>& sketch, int binCount) {
+    if (binCount <= 0) throw std::invalid_argument("binCount must be > 0");
+    if (sketch.GetCount() == 0) throw std::invalid_argument("MakeEquiDepthBins: sketch is empty");
+
+    DynamicArray<Key> edges(binCount + 1);
+    int e = 0;
+    edges.Set(e++, sketch.GetMin());
+    for (int i = 1; i < binCount; ++i) {
+        Key q = sketch.Quantile((double)i / binCount);
+        if (edges.Get(e - 1) < q) edges.Set(e++, q);
+    }
+    Key upper = quantile_detail::NextAbove(sketch.GetMax());
+    if (!(edges.Get(e - 1) < upper)) upper = sketch.GetMax();
+    if (edges.Get(e - 1) < upper) edges.Set(e++, upper);
+    if (e == 1) edges.Set(e++, upper); // все значения равны максимуму типа
+
+    ArraySequence< Range<Key> >* bins = new ArraySequence< Range<Key> >();
+    bins->SetAt(0, Range<Key>{ edges.Get(0), edges.Get(1) });
+    for (int i = 1; i + 1 < e; ++i)
+        bins->Append(Range<Key>{ edges.Get(i), edges.Get(i + 1) });
+    return bins;
+}
+
+// Один проход по seq: скетч значений проектора
+template <typename T, typename Key>
+QuantileSketch<Key>* SketchSequence(ArraySequence<T>* seq, Key (*projector)(const T&), int k = 200) {
+    if (!seq) throw std::invalid_argument("SketchSequence: seq is null");
+    if (!projector) throw std::invalid_argument("SketchSequence: projector is null");
+    QuantileSketch<Key>* sketch = new QuantileSketch<Key>(k);
+    From(seq).Map(projector).ForEach([sketch](const Key& value) { sketch->Update(value); });
+    return sketch;
+}
+
+// Оценка счётчиков по бинам только из скетча (без повторного прохода по данным)
+template <typename Key>
+IDictionary< Range<Key>, int >*
+EstimateHistogram(const QuantileSketch<Key>& sketch, const ArraySequence< Range<Key> >* bins) {
+    int B = bins->GetLength();
+    DynamicArray<int> counts(B);
+    for (int i = 0; i < B; ++i) {
+        Range<Key> bin = bins->Get(i);
+        unsigned long long lo = sketch.Rank(bin.lo);
+        unsigned long long hi = (i == B - 1 && !(sketch.GetMax() < bin.hi)) ? sketch.GetCount() : sketch.Rank(bin.hi);
+        counts.Set(i, (hi > lo) ? (int)(hi - lo) : 0);
+    }
+    return MakeHistogramDictionary(bins, counts.GetData());
+}
+
+// Равноглубинная гистограмма: проход 1 — скетч и раскладка бинов,
+// проход 2 — точные счётчики двоичным поиском по бинам.
+// Из par используются binCount и Projector; границы берутся из данных.
+// bins (если не nullptr) получает раскладку; освобождает вызывающий.
+template <typename T, typename Key>
+IDictionary< Range<Key>, int >*
+BuildEquiDepthHistogram(ArraySequence<T>* seq, const HistogramParams<T, Key>& par,
+                        ArraySequence< Range<Key> >** bins = nullptr, int k = 200)
+{
+    if (par.binCount <= 0) throw std::invalid_argument("binCount must be > 0");
+    QuantileSketch<Key>* sketch = SketchSequence(seq, par.Projector, k);
+    if (sketch->GetCount() == 0) {
+        delete sketch;
+        throw std::invalid_argument("BuildEquiDepthHistogram: seq is empty");
+    }
+    ArraySequence< Range<Key> >* layout;
+    try {
+        layout = MakeEquiDepthBins(*sketch, par.binCount);
+    } catch (...) {
+        delete sketch;
+        throw;
+    }
+    delete sketch;
+    IDictionary< Range<Key>, int >* dict;
+    try {
+        dict = BuildHistogramWithBins(seq, par.Projector, layout);
+    } catch (...) {
+        delete layout;
+        throw;
+    }
+    if (bins) *bins = layout;
+    else delete layout;
+    return dict;
+}
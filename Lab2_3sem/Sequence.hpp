@@ -30,10 +30,18 @@ protected:
     Sequence(Sequence<T>* other) : Container<T>(other) {};
 };
 
+// Счётчики трассировки ArraySequence/ListSequence относятся к операциям
+// самой последовательности (сдвиги, временные буферы, промежуточные копии);
+// работа нижележащих DynamicArray/LinkedList идёт в их собственные строки.
 template <typename T> class ArraySequence : public Sequence<T> {
 private:
     DynamicArray<T> data;
 
+    [[noreturn]] static void OutOfRange(const char* message) {
+        LAB2_TRACE_EVENT(ArraySequence, BoundsFailures, 1);
+        throw out_of_range(message);
+    }
+
 public:
     ArraySequence() : data(1) {}
 
@@ -65,7 +73,10 @@ public:
     }
 
     Sequence<T>* GetSubsequence(size_t start, size_t end) const override {
-        if (start > end || end >= GetLength()) throw out_of_range("Invalid range");
+        if (start > end || end >= GetLength()) OutOfRange("Invalid range");
+        LAB2_TRACE_EVENT(ArraySequence, Allocations, 1);
+        LAB2_TRACE_EVENT(ArraySequence, AllocatedBytes, (end - start + 1) * sizeof(T));
+        LAB2_TRACE_EVENT(ArraySequence, Copies, end - start + 1);
         T* temp = new T[end - start + 1];
         for (size_t i = 0; i <= end - start; i++)
             temp[i] = data.Get(start + i);
@@ -75,6 +86,7 @@ public:
     }
 
     Sequence<T>* Append(T item) override {
+        LAB2_TRACE_EVENT(ArraySequence, Resizes, 1);
         data.Resize(data.GetSize() + 1);
         data.Set(data.GetSize() - 1, item);
         return this;
@@ -82,6 +94,8 @@ public:
 
     Sequence<T>* Prepend(T item) override {
         size_t size = data.GetSize();
+        LAB2_TRACE_EVENT(ArraySequence, Resizes, 1);
+        LAB2_TRACE_EVENT(ArraySequence, Moves, size);
         data.Resize(size + 1);
         for (size_t i = size; i > 0; i--)
             data.Set(i, data.Get(i - 1));
@@ -90,7 +104,9 @@ public:
     }
 
     Sequence<T>* InsertAt(T item, size_t index) override {
-        if (index > data.GetSize()) throw out_of_range("Index out of range");
+        if (index > data.GetSize()) OutOfRange("Index out of range");
+        LAB2_TRACE_EVENT(ArraySequence, Resizes, 1);
+        LAB2_TRACE_EVENT(ArraySequence, Moves, data.GetSize() - index);
         data.Resize(data.GetSize() + 1);
         for (size_t i = data.GetSize() - 1; i > index; i--)
             data.Set(i, data.Get(i - 1));
@@ -100,6 +116,9 @@ public:
 
     Sequence<T>* Concat(Sequence<T>* list) const override {
         size_t total = GetLength() + list->GetLength();
+        LAB2_TRACE_EVENT(ArraySequence, Allocations, 1);
+        LAB2_TRACE_EVENT(ArraySequence, AllocatedBytes, total * sizeof(T));
+        LAB2_TRACE_EVENT(ArraySequence, Copies, total);
         T* combined = new T[total];
         for (size_t i = 0; i < GetLength(); i++)
             combined[i] = Get(i);
@@ -136,6 +155,27 @@ public:
         return data.Norm();
     }
 
+    Sequence<T>* Add(const Sequence<T>* other, ThreadPool& pool) const {
+        if (GetLength() != other->GetLength()) throw invalid_argument("Size mismatch in addition");
+        DynamicArray<T> otherData(GetLength());
+        for (size_t i = 0; i < GetLength(); i++)
+            otherData.Set(i, other->Get(i));
+        return new ArraySequence<T>(data.Add(otherData, pool));
+    }
+
+    Sequence<T>* MultiplyByScalar(T scalar, ThreadPool& pool) const {
+        return new ArraySequence<T>(data.Multiply(scalar, pool));
+    }
+
+    T Dot(const ArraySequence<T>* other, ThreadPool& pool, ReduceOrder order = ReduceOrder::Pinned) const {
+        if (GetLength() != other->GetLength()) throw invalid_argument("Size mismatch in dot product");
+        return data.Dot(other->data, pool, order);
+    }
+
+    double Norm(ThreadPool& pool, ReduceOrder order = ReduceOrder::Pinned) const {
+        return data.Norm(pool, order);
+    }
+
     T& GetRef(size_t index) {
         return data.GetRef(index); // DynamicArray<T> возврат T& на буфер[index]
     }
@@ -143,13 +183,22 @@ public:
         return data.GetRef(index);
     }
 
+    T* GetData() {
+        return data.GetData();
+    }
+    const T* GetData() const {
+        return data.GetData();
+    }
+
     void SetAt(size_t index, const T& item) {
         data.Set(index, item);
     }
 
     void Delete(size_t index) {
         size_t n = data.GetSize();
-        if (index >= n) throw std::out_of_range("Index out of range");
+        if (index >= n) OutOfRange("Index out of range");
+        LAB2_TRACE_EVENT(ArraySequence, Resizes, 1);
+        LAB2_TRACE_EVENT(ArraySequence, Moves, n - 1 - index);
         // сдвиг влево
         for (size_t i = index; i + 1 < n; ++i)
             data.Set(i, data.Get(i + 1));
@@ -185,7 +234,9 @@ public:
     }
 
     Sequence<T>* GetSubsequence(size_t start, size_t end) const override {
-        return new ListSequence<T>(*list.GetSubList(start, end));
+        auto* subList = list.GetSubList(start, end);
+        LAB2_TRACE_EVENT(ListSequence, Copies, subList->GetLength()); // промежуточный подсписок копируется ещё раз
+        return new ListSequence<T>(*subList);
     }
 
     Sequence<T>* Append(T item) override {
@@ -205,8 +256,13 @@ public:
 
     Sequence<T>* Concat(Sequence<T>* other) const override {
         auto* newList = list.Concat(&(dynamic_cast<ListSequence<T>*>(other)->list));
+        LAB2_TRACE_EVENT(ListSequence, Copies, newList->GetLength()); // и здесь
         return new ListSequence<T>(*newList);
     }
+
+    template <typename Cmp> void NaturalMergeSort(Cmp cmp) {
+        list.NaturalMergeSort(cmp);
+    }
 };
 
 
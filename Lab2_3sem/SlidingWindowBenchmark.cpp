@@ -0,0 +1,45 @@
+// Стоимость одного события в SlidingWindowHistogram при разной длине окна.
+// Сборка: g++ -std=c++17 -O2 -pthread SlidingWindowBenchmark.cpp -o window_bench
+#include "SlidingWindowHistogram.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main() {
+    const int kBins = 64;
+    const long long kSliceMs = 1000;
+    const long long kEventsPerSecond = 200000;
+    const long long kSeconds = 600;
+
+    std::mt19937 rng(7);
+    std::vector<int> latencies(1 << 16);
+    for (size_t i = 0; i < latencies.size(); i++)
+        latencies[i] = static_cast<int>(rng() % 2000);
+
+    std::cout << "events/s = " << kEventsPerSecond << ", seconds = " << kSeconds
+              << ", bins = " << kBins << ", slice = " << kSliceMs << " ms\n\n";
+    std::cout << "window      ns/event   events in window\n";
+
+    const long long windows[] = { 10 * 1000, 60 * 1000, 5 * 60 * 1000, 60 * 60 * 1000 };
+    for (long long windowMs : windows) {
+        SlidingWindowHistogram<int> h(0, 2000, kBins, kSliceMs, windowMs);
+        size_t k = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (long long sec = 0; sec < kSeconds; sec++) {
+            long long base = sec * 1000;
+            for (long long e = 0; e < kEventsPerSecond; e++) {
+                long long t = base + (e * 1000) / kEventsPerSecond;
+                h.Add(t, latencies[k++ & (latencies.size() - 1)]);
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        std::cout.width(6);
+        std::cout << windowMs / 1000 << " s  ";
+        std::cout.width(10);
+        std::cout << ns / double(kEventsPerSecond * kSeconds) << "   " << h.GetTotal() << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include "Histogram.hpp"
+
+// Гистограмма по скользящему окну времени ("последние 5 минут").
+// Окно делится на срезы ширины sliceWidth; для каждого среза хранится свой
+// массив счётчиков (кольцо), а totals — их сумма по всему окну.
+//   Add     — O(1): счётчик среза и итог
+//   Advance — O(бинов) на каждый истёкший срез: его счётчики вычитаются из итога
+//   Запрос  — O(1) на бин, итог уже посчитан
+// Время — целые "тики" в единицах вызывающей стороны (мс, с и т.п.).
+template <typename Key>
+class SlidingWindowHistogram {
+private:
+    ArraySequence< Range<Key> >* bins;
+    UniformBinLocator<Key> locate;
+    int binCount;
+    long long sliceWidth;
+    long long sliceCount;
+    DynamicArray<int> ring;     // sliceCount × binCount, срез s — в строке s % sliceCount
+    DynamicArray<int> totals;   // сумма по живым срезам
+    long long head;             // номер самого нового среза
+    bool started;
+
+    long long SliceOf(long long time) const {
+        // деление с округлением вниз и для отрицательного времени
+        long long q = time / sliceWidth;
+        return (time % sliceWidth < 0) ? q - 1 : q;
+    }
+
+    int* Row(long long slice) {
+        long long r = slice % sliceCount;
+        if (r < 0) r += sliceCount;
+        return ring.GetData() + r * binCount;
+    }
+
+    void ClearAll() {
+        int* r = ring.GetData();
+        for (long long i = 0; i < sliceCount * binCount; i++) r[i] = 0;
+        int* t = totals.GetData();
+        for (int i = 0; i < binCount; i++) t[i] = 0;
+    }
+
+public:
+    // windowLength округляется вверх до целого числа срезов
+    SlidingWindowHistogram(Key minVal, Key maxVal, int binCount, long long sliceWidth, long long windowLength)
+    : bins(MakeUniformBins<Key>(minVal, maxVal, binCount)),
+      locate(bins, minVal, maxVal),
+      binCount(binCount),
+      sliceWidth(sliceWidth),
+      sliceCount(sliceWidth > 0 ? (windowLength + sliceWidth - 1) / sliceWidth : 0),
+      ring(1), totals(binCount), head(0), started(false)
+    {
+        if (sliceWidth <= 0 || windowLength <= 0) {
+            delete bins;
+            throw std::invalid_argument("SlidingWindowHistogram: slice width and window length must be > 0");
+        }
+        try {
+            ring.Resize((size_t)(sliceCount * binCount));
+        } catch (...) {
+            delete bins;
+            throw;
+        }
+        ClearAll();
+    }
+
+    SlidingWindowHistogram(const SlidingWindowHistogram&) = delete;
+    SlidingWindowHistogram& operator=(const SlidingWindowHistogram&) = delete;
+
+    ~SlidingWindowHistogram() {
+        delete bins;
+    }
+
+    // Сдвигает окно так, чтобы его последний срез содержал момент now.
+    // Время назад не идёт: более ранний now игнорируется.
+    void Advance(long long now) {
+        long long target = SliceOf(now);
+        if (!started) {
+            head = target;
+            started = true;
+            return;
+        }
+        if (target <= head) return;
+        if (target - head >= sliceCount) {
+            ClearAll();
+        } else {
+            int* t = totals.GetData();
+            for (long long s = head + 1; s <= target; s++) {
+                int* row = Row(s);  // строка самого старого среза, который выпадает из окна
+                for (int i = 0; i < binCount; i++) {
+                    t[i] -= row[i];
+                    row[i] = 0;
+                }
+            }
+        }
+        head = target;
+    }
+
+    // Событие value в момент time; окно при необходимости сдвигается.
+    // Запоздавшие события попадают в свой срез, если он ещё в окне.
+    // Возвращает false, если событие уже за пределами окна или вне бинов.
+    bool Add(long long time, const Key& value) {
+        Advance(time);
+        long long slice = SliceOf(time);
+        if (slice <= head - sliceCount) return false;
+        int j = locate(value);
+        if (j < 0) return false;
+        ++Row(slice)[j];
+        ++totals.GetData()[j];
+        return true;
+    }
+
+    int GetBinCount() const { return binCount; }
+    Range<Key> GetBin(int i) const { return bins->Get(i); }
+    long long GetSliceWidth() const { return sliceWidth; }
+    long long GetWindowLength() const { return sliceWidth * sliceCount; }
+
+    int GetCount(int bin) const {
+        return totals.Get(bin);
+    }
+
+    const int* GetCounts() const {
+        return totals.GetData();
+    }
+
+    long long GetTotal() const {
+        long long sum = 0;
+        for (int i = 0; i < binCount; i++) sum += totals.Get(i);
+        return sum;
+    }
+
+    // Текущее окно в виде результата BuildHistogram
+    IDictionary< Range<Key>, int >* ToDictionary() const {
+        return MakeHistogramDictionary(bins, totals.GetData());
+    }
+};
@@ -0,0 +1,176 @@
+#pragma once
+#include "Sequence.hpp"
+
+#include <utility>
+
+// Последовательность с N встроенными ячейками (small-buffer optimization).
+// Пока элементов не больше N, они хранятся внутри объекта и куча не трогается;
+// при переполнении данные переезжают в динамический буфер с удвоением ёмкости.
+// В отличие от ArraySequence, может быть пустой.
+template <typename T, size_t N> class SmallArraySequence : public Sequence<T> {
+    static_assert(N > 0, "SmallArraySequence: N must be > 0");
+
+private:
+    T inlineItems[N];
+    T* heap;
+    size_t capacity;
+    size_t length;
+
+    [[noreturn]] static void OutOfRange(const char* message) {
+        LAB2_TRACE_EVENT(SmallArraySequence, BoundsFailures, 1);
+        throw out_of_range(message);
+    }
+
+    T* Items() {
+        return heap ? heap : inlineItems;
+    }
+    const T* Items() const {
+        return heap ? heap : inlineItems;
+    }
+
+    void Reserve(size_t needed) {
+        if (needed <= capacity) return;
+        size_t newCapacity = capacity * 2;
+        if (newCapacity < needed) newCapacity = needed;
+        T* grown;
+        try {
+            grown = new T[newCapacity];
+        } catch (const bad_alloc& e) {
+            throw runtime_error("Memory allocation failed in SmallArraySequence");
+        }
+        LAB2_TRACE_EVENT(SmallArraySequence, Resizes, 1);
+        LAB2_TRACE_EVENT(SmallArraySequence, Allocations, 1);
+        LAB2_TRACE_EVENT(SmallArraySequence, AllocatedBytes, newCapacity * sizeof(T));
+        LAB2_TRACE_EVENT(SmallArraySequence, Moves, length);
+        T* items = Items();
+        for (size_t i = 0; i < length; i++)
+            grown[i] = std::move(items[i]);
+        delete[] heap;
+        heap = grown;
+        capacity = newCapacity;
+    }
+
+    void CopyFrom(const T* items, size_t count) {
+        Reserve(count);
+        T* dst = Items();
+        LAB2_TRACE_EVENT(SmallArraySequence, Copies, count);
+        for (size_t i = 0; i < count; i++)
+            dst[i] = items[i];
+        length = count;
+    }
+
+public:
+    SmallArraySequence() : heap(nullptr), capacity(N), length(0) {}
+
+    SmallArraySequence(const T* items, size_t count) : heap(nullptr), capacity(N), length(0) {
+        CopyFrom(items, count);
+    }
+
+    SmallArraySequence(const SmallArraySequence& other) : Sequence<T>(), heap(nullptr), capacity(N), length(0) {
+        CopyFrom(other.Items(), other.length);
+    }
+
+    SmallArraySequence& operator=(const SmallArraySequence& other) {
+        if (this != &other) {
+            length = 0;
+            CopyFrom(other.Items(), other.length);
+        }
+        return *this;
+    }
+
+    ~SmallArraySequence() {
+        delete[] heap;
+    }
+
+    T GetFirst() const override {
+        if (length == 0) OutOfRange("Sequence is empty");
+        return Items()[0];
+    }
+
+    T GetLast() const override {
+        if (length == 0) OutOfRange("Sequence is empty");
+        return Items()[length - 1];
+    }
+
+    T Get(size_t index) const override {
+        if (index >= length) OutOfRange("Index out of range");
+        return Items()[index];
+    }
+
+    size_t GetLength() const override {
+        return length;
+    }
+
+    Sequence<T>* GetSubsequence(size_t start, size_t end) const override {
+        if (start > end || end >= length) OutOfRange("Invalid range");
+        return new SmallArraySequence<T, N>(Items() + start, end - start + 1);
+    }
+
+    Sequence<T>* Append(T item) override {
+        Reserve(length + 1);
+        Items()[length++] = item;
+        return this;
+    }
+
+    Sequence<T>* Prepend(T item) override {
+        return InsertAt(item, 0);
+    }
+
+    Sequence<T>* InsertAt(T item, size_t index) override {
+        if (index > length) OutOfRange("Index out of range");
+        Reserve(length + 1);
+        LAB2_TRACE_EVENT(SmallArraySequence, Moves, length - index);
+        T* items = Items();
+        for (size_t i = length; i > index; i--)
+            items[i] = std::move(items[i - 1]);
+        items[index] = item;
+        length++;
+        return this;
+    }
+
+    Sequence<T>* Concat(Sequence<T>* list) const override {
+        auto* result = new SmallArraySequence<T, N>(*this);
+        for (size_t i = 0; i < list->GetLength(); i++)
+            result->Append(list->Get(i));
+        return result;
+    }
+
+    T& GetRef(size_t index) {
+        if (index >= length) OutOfRange("Index out of range");
+        return Items()[index];
+    }
+    const T& GetRef(size_t index) const {
+        if (index >= length) OutOfRange("Index out of range");
+        return Items()[index];
+    }
+
+    T* GetData() {
+        return Items();
+    }
+    const T* GetData() const {
+        return Items();
+    }
+
+    void SetAt(size_t index, const T& item) {
+        if (index >= length) OutOfRange("Index out of range");
+        Items()[index] = item;
+    }
+
+    void Delete(size_t index) {
+        if (index >= length) OutOfRange("Index out of range");
+        LAB2_TRACE_EVENT(SmallArraySequence, Moves, length - 1 - index);
+        T* items = Items();
+        for (size_t i = index; i + 1 < length; ++i)
+            items[i] = std::move(items[i + 1]);
+        length--;
+    }
+
+    // Обнуляет длину, сохраняя ёмкость
+    void Clear() {
+        length = 0;
+    }
+
+    bool IsInline() const {
+        return heap == nullptr;
+    }
+};
@@ -0,0 +1,292 @@
+#pragma once
+#include "Histogram.hpp"
+#include "ThreadPool.hpp"
+
+#include <climits>
+#include <type_traits>
+#include <utility>
+
+// Сортировки над Sequence<T> с подключаемыми компараторами.
+// Компаратор — любой функтор cmp(a, b), возвращающий true, если a строго меньше b.
+//   IntroSort          — на месте, для ArraySequence (неустойчивая)
+//   ParallelMergeSort  — устойчивая, все ядра пула, O(n) доп. памяти
+//   RadixSort          — LSD по байтам для целых ключей и ключей-проекций
+//   NaturalMergeSort   — перевязывает узлы LinkedList без копирования
+
+template <typename T> struct Less {
+    bool operator()(const T& a, const T& b) const { return a < b; }
+};
+
+template <typename T> struct Greater {
+    bool operator()(const T& a, const T& b) const { return b < a; }
+};
+
+// Сравнение записей по ключу-проекции (как HistogramParams::Projector)
+template <typename T, typename Key> struct ByKey {
+    Key (*Projector)(const T&);
+    explicit ByKey(Key (*projector)(const T&)) : Projector(projector) {}
+    bool operator()(const T& a, const T& b) const { return Projector(a) < Projector(b); }
+};
+
+namespace sort_detail {
+    const size_t kInsertionThreshold = 16;
+
+    template <typename T, typename Cmp>
+    void InsertionSort(T* data, size_t lo, size_t hi, Cmp& cmp) {
+        for (size_t i = lo + 1; i < hi; i++) {
+            T item = std::move(data[i]);
+            size_t j = i;
+            while (j > lo && cmp(item, data[j - 1])) {
+                data[j] = std::move(data[j - 1]);
+                --j;
+            }
+            data[j] = std::move(item);
+        }
+    }
+
+    template <typename T, typename Cmp>
+    void SiftDown(T* data, size_t root, size_t n, Cmp& cmp) {
+        for (;;) {
+            size_t child = 2 * root + 1;
+            if (child >= n) return;
+            if (child + 1 < n && cmp(data[child], data[child + 1])) ++child;
+            if (!cmp(data[root], data[child])) return;
+            std::swap(data[root], data[child]);
+            root = child;
+        }
+    }
+
+    template <typename T, typename Cmp>
+    void HeapSort(T* data, size_t n, Cmp& cmp) {
+        for (size_t i = n / 2; i > 0; i--)
+            SiftDown(data, i - 1, n, cmp);
+        for (size_t end = n; end > 1; end--) {
+            std::swap(data[0], data[end - 1]);
+            SiftDown(data, 0, end - 1, cmp);
+        }
+    }
+
+    // Медиана трёх (a, b, c) переносится в data[first]
+    template <typename T, typename Cmp>
+    void MoveMedianToFirst(T* data, size_t first, size_t a, size_t b, size_t c, Cmp& cmp) {
+        if (cmp(data[a], data[b])) {
+            if (cmp(data[b], data[c]))      std::swap(data[first], data[b]);
+            else if (cmp(data[a], data[c])) std::swap(data[first], data[c]);
+            else                            std::swap(data[first], data[a]);
+        } else if (cmp(data[a], data[c]))   std::swap(data[first], data[a]);
+        else if (cmp(data[b], data[c]))     std::swap(data[first], data[c]);
+        else                                std::swap(data[first], data[b]);
+    }
+
+    template <typename T, typename Cmp>
+    void IntroSortLoop(T* data, size_t lo, size_t hi, size_t depth, Cmp& cmp) {
+        while (hi - lo > kInsertionThreshold) {
+            if (depth == 0) {
+                HeapSort(data + lo, hi - lo, cmp);
+                return;
+            }
+            --depth;
+            MoveMedianToFirst(data, lo, lo + 1, lo + (hi - lo) / 2, hi - 1, cmp);
+            // Разбиение Хоара; медиана трёх служит ограничителем для обоих сканов
+            size_t left = lo + 1;
+            size_t right = hi;
+            for (;;) {
+                while (cmp(data[left], data[lo])) ++left;
+                --right;
+                while (cmp(data[lo], data[right])) --right;
+                if (!(left < right)) break;
+                std::swap(data[left], data[right]);
+                ++left;
+            }
+            IntroSortLoop(data, left, hi, depth, cmp);
+            hi = left;
+        }
+        InsertionSort(data, lo, hi, cmp);
+    }
+
+    // Устойчивое слияние a[0..la) и b[0..lb) в out
+    template <typename T, typename Cmp>
+    void MergeInto(const T* a, size_t la, const T* b, size_t lb, T* out, Cmp& cmp) {
+        size_t i = 0, j = 0;
+        while (i < la && j < lb) {
+            if (cmp(b[j], a[i])) *out++ = b[j++];
+            else                 *out++ = a[i++];
+        }
+        while (i < la) *out++ = a[i++];
+        while (j < lb) *out++ = b[j++];
+    }
+
+    // Сколько элементов из a попадает в первые d элементов слияния a и b
+    template <typename T, typename Cmp>
+    size_t CoRank(size_t d, const T* a, size_t la, const T* b, size_t lb, Cmp& cmp) {
+        size_t lo = (d > lb) ? d - lb : 0;
+        size_t hi = (d < la) ? d : la;
+        while (lo < hi) {
+            size_t i = lo + (hi - lo) / 2;
+            size_t j = d - i;
+            if (j > 0 && i < la && !cmp(b[j - 1], a[i])) lo = i + 1;
+            else hi = i;
+        }
+        return lo;
+    }
+
+    template <typename T, typename Cmp>
+    void MergeSortRange(T* data, T* buf, size_t lo, size_t hi, Cmp& cmp) {
+        if (hi - lo <= 2 * kInsertionThreshold) {
+            InsertionSort(data, lo, hi, cmp);
+            return;
+        }
+        size_t mid = lo + (hi - lo) / 2;
+        MergeSortRange(data, buf, lo, mid, cmp);
+        MergeSortRange(data, buf, mid, hi, cmp);
+        if (!cmp(data[mid], data[mid - 1])) return; // уже упорядочено
+        for (size_t i = lo; i < hi; i++) buf[i] = data[i];
+        MergeInto(buf + lo, mid - lo, buf + mid, hi - mid, data + lo, cmp);
+    }
+
+    template <typename U, typename T, typename KeyFn>
+    void RadixSortByKey(T* data, size_t n, KeyFn key) {
+        static_assert(std::is_unsigned<U>::value, "RadixSort: key must map to an unsigned type");
+        if (n < 2) return;
+        DynamicArray<U> keys(n);
+        DynamicArray<U> keysTmp(n);
+        DynamicArray<T> itemsTmp(n);
+        U* k = keys.GetData();
+        U* kt = keysTmp.GetData();
+        T* src = data;
+        T* dst = itemsTmp.GetData();
+        // Ключи считаются один раз и переставляются вместе с элементами
+        for (size_t i = 0; i < n; i++) k[i] = key(data[i]);
+
+        for (size_t shift = 0; shift < sizeof(U) * CHAR_BIT; shift += 8) {
+            size_t count[256] = {};
+            for (size_t i = 0; i < n; i++) count[(k[i] >> shift) & 0xFF]++;
+            if (count[(k[0] >> shift) & 0xFF] == n) continue; // байт одинаков у всех
+            size_t offset = 0;
+            for (size_t b = 0; b < 256; b++) {
+                size_t c = count[b];
+                count[b] = offset;
+                offset += c;
+            }
+            for (size_t i = 0; i < n; i++) {
+                size_t pos = count[(k[i] >> shift) & 0xFF]++;
+                dst[pos] = src[i];
+                kt[pos] = k[i];
+            }
+            std::swap(src, dst);
+            std::swap(k, kt);
+        }
+        if (src != data)
+            for (size_t i = 0; i < n; i++) data[i] = src[i];
+    }
+
+    // Отображение целого ключа в беззнаковый с сохранением порядка
+    template <typename Key>
+    typename std::make_unsigned<Key>::type OrderedBits(Key value) {
+        typedef typename std::make_unsigned<Key>::type U;
+        U u = static_cast<U>(value);
+        if (std::is_signed<Key>::value)
+            u ^= static_cast<U>(U(1) << (sizeof(U) * CHAR_BIT - 1));
+        return u;
+    }
+}
+
+template <typename T, typename Cmp = Less<T> >
+void IntroSort(T* data, size_t n, Cmp cmp = Cmp()) {
+    if (n < 2) return;
+    size_t depth = 0;
+    for (size_t m = n; m > 1; m >>= 1) depth += 2;
+    sort_detail::IntroSortLoop(data, 0, n, depth, cmp);
+}
+
+template <typename T, typename Cmp = Less<T> >
+void IntroSort(ArraySequence<T>& seq, Cmp cmp = Cmp()) {
+    IntroSort(seq.GetData(), seq.GetLength(), cmp);
+}
+
+// Листовые блоки сортируются параллельно, затем каждый проход слияния
+// делится по выходным позициям (co-rank), так что все ядра заняты
+// и на последних проходах, где пар для слияния мало.
+template <typename T, typename Cmp = Less<T> >
+void ParallelMergeSort(ArraySequence<T>& seq, Cmp cmp = Cmp(), ThreadPool& pool = ThreadPool::Default()) {
+    size_t n = seq.GetLength();
+    if (n < 2) return;
+    T* data = seq.GetData();
+    DynamicArray<T> buffer(n);
+    T* buf = buffer.GetData();
+
+    size_t block = ParallelChunkSize(n, pool.GetWorkerCount(), 4096, ReduceOrder::Adaptive);
+    auto leaf = [&](size_t, size_t lo, size_t hi) { sort_detail::MergeSortRange(data, buf, lo, hi, cmp); };
+    parallel_detail::RunChunks(pool, n, block, leaf);
+
+    T* src = data;
+    T* dst = buf;
+    for (size_t width = block; width < n; width *= 2) {
+        auto pass = [&](size_t, size_t lo, size_t hi) {
+            size_t pos = lo;
+            while (pos < hi) {
+                size_t p0 = (pos / (2 * width)) * (2 * width);
+                size_t pmid = (p0 + width < n) ? p0 + width : n;
+                size_t pend = (p0 + 2 * width < n) ? p0 + 2 * width : n;
+                size_t segEnd = (hi < pend) ? hi : pend;
+                const T* a = src + p0;
+                const T* b = src + pmid;
+                size_t la = pmid - p0, lb = pend - pmid;
+                size_t d0 = pos - p0, d1 = segEnd - p0;
+                size_t i0 = sort_detail::CoRank(d0, a, la, b, lb, cmp);
+                size_t i1 = sort_detail::CoRank(d1, a, la, b, lb, cmp);
+                sort_detail::MergeInto(a + i0, i1 - i0, b + (d0 - i0), (d1 - i1) - (d0 - i0), dst + pos, cmp);
+                pos = segEnd;
+            }
+        };
+        parallel_detail::RunChunks(pool, n, block, pass);
+        std::swap(src, dst);
+    }
+    if (src != data) {
+        ParallelFor(pool, n, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; i++) data[i] = src[i];
+        });
+    }
+}
+
+// Целые ключи
+template <typename T>
+void RadixSort(ArraySequence<T>& seq) {
+    static_assert(std::is_integral<T>::value, "RadixSort: T must be an integer type (or pass a projector)");
+    typedef typename std::make_unsigned<T>::type U;
+    sort_detail::RadixSortByKey<U>(seq.GetData(), seq.GetLength(),
+        [](const T& x) { return sort_detail::OrderedBits(x); });
+}
+
+// Записи с целым ключом-проекцией; устойчивая
+template <typename T, typename Key>
+void RadixSort(ArraySequence<T>& seq, Key (*projector)(const T&)) {
+    static_assert(std::is_integral<Key>::value, "RadixSort: projector must return an integer key");
+    if (!projector) throw std::invalid_argument("RadixSort: projector is null");
+    typedef typename std::make_unsigned<Key>::type U;
+    sort_detail::RadixSortByKey<U>(seq.GetData(), seq.GetLength(),
+        [projector](const T& x) { return sort_detail::OrderedBits(projector(x)); });
+}
+
+template <typename T, typename Key>
+void RadixSort(ArraySequence<T>& seq, const HistogramParams<T, Key>& par) {
+    RadixSort(seq, par.Projector);
+}
+
+template <typename T, typename Cmp = Less<T> >
+void NaturalMergeSort(ListSequence<T>& seq, Cmp cmp = Cmp()) {
+    seq.NaturalMergeSort(cmp);
+}
+
+// Выбор алгоритма по типу последовательности
+template <typename T, typename Cmp = Less<T> >
+void Sort(Sequence<T>* seq, Cmp cmp = Cmp()) {
+    if (!seq) throw std::invalid_argument("Sort: seq is null");
+    if (ArraySequence<T>* arr = dynamic_cast<ArraySequence<T>*>(seq)) {
+        IntroSort(*arr, cmp);
+    } else if (ListSequence<T>* list = dynamic_cast<ListSequence<T>*>(seq)) {
+        NaturalMergeSort(*list, cmp);
+    } else {
+        throw std::invalid_argument("Sort: unsupported sequence type");
+    }
+}
@@ -0,0 +1,107 @@
+// Сравнение сортировок Sort.hpp со std::sort.
+// Сборка: g++ -std=c++17 -O2 -pthread SortBenchmark.cpp -o sort_bench
+#include "Sort.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+struct Person { int age; int id; };
+static int ProjectAge(const Person& p) { return p.age; }
+
+template <typename F>
+static double TimeMs(F fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename T, typename Cmp>
+static bool IsSorted(const ArraySequence<T>& seq, Cmp cmp) {
+    const T* d = seq.GetData();
+    for (size_t i = 1; i < seq.GetLength(); i++)
+        if (cmp(d[i], d[i - 1])) return false;
+    return true;
+}
+
+static void Report(const char* name, double ms, bool ok) {
+    std::cout.width(22);
+    std::cout << name << "  ";
+    std::cout.width(10);
+    std::cout << ms << " ms" << (ok ? "" : "   NOT SORTED") << "\n";
+}
+
+int main(int argc, char** argv) {
+    size_t n = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    if (n == 0) n = 1;
+    std::mt19937 rng(42);
+    std::vector<int> ints(n);
+    for (size_t i = 0; i < n; i++) ints[i] = static_cast<int>(rng());
+
+    std::cout << "n = " << n << ", threads = " << ThreadPool::Default().GetWorkerCount() << "\n\n";
+    std::cout << "int keys\n";
+    {
+        std::vector<int> v(ints);
+        double ms = TimeMs([&] { std::sort(v.begin(), v.end()); });
+        Report("std::sort", ms, std::is_sorted(v.begin(), v.end()));
+    }
+    {
+        ArraySequence<int> s(ints.data(), n);
+        double ms = TimeMs([&] { IntroSort(s); });
+        Report("IntroSort", ms, IsSorted(s, Less<int>()));
+    }
+    {
+        ArraySequence<int> s(ints.data(), n);
+        double ms = TimeMs([&] { ParallelMergeSort(s); });
+        Report("ParallelMergeSort", ms, IsSorted(s, Less<int>()));
+    }
+    {
+        ArraySequence<int> s(ints.data(), n);
+        double ms = TimeMs([&] { RadixSort(s); });
+        Report("RadixSort", ms, IsSorted(s, Less<int>()));
+    }
+
+    std::vector<Person> people(n);
+    for (size_t i = 0; i < n; i++) people[i] = Person{ static_cast<int>(rng() % 100), static_cast<int>(i) };
+    ByKey<Person, int> byAge(&ProjectAge);
+
+    std::cout << "\nPerson by age\n";
+    {
+        std::vector<Person> v(people);
+        double ms = TimeMs([&] { std::stable_sort(v.begin(), v.end(), byAge); });
+        Report("std::stable_sort", ms, std::is_sorted(v.begin(), v.end(), byAge));
+    }
+    {
+        ArraySequence<Person> s(people.data(), n);
+        double ms = TimeMs([&] { ParallelMergeSort(s, byAge); });
+        Report("ParallelMergeSort", ms, IsSorted(s, byAge));
+    }
+    {
+        HistogramParams<Person, int> hp;
+        hp.minVal = 0; hp.maxVal = 100; hp.binCount = 10;
+        hp.Projector = &ProjectAge;
+        ArraySequence<Person> s(people.data(), n);
+        double ms = TimeMs([&] { RadixSort(s, hp); });
+        Report("RadixSort(projector)", ms, IsSorted(s, byAge));
+    }
+
+    std::cout << "\nListSequence<int>\n";
+    {
+        size_t m = (n < 20000) ? n : 20000; // построение списка O(m^2)
+        ListSequence<int> list(ints.data(), m);
+        double ms = TimeMs([&] { NaturalMergeSort(list); });
+        bool ok = true;
+        int prev = list.GetFirst();
+        for (size_t i = 1; i < 1000 && i < m; i++) {
+            int cur = list.Get(i);
+            if (cur < prev) ok = false;
+            prev = cur;
+        }
+        Report("NaturalMergeSort", ms, ok);
+    }
+    return 0;
+}
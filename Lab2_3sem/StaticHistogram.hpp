@@ -0,0 +1,100 @@
+#pragma once
+#include "Histogram.hpp"
+
+#include <array>
+#include <type_traits>
+
+// Гистограмма с раскладкой бинов времени компиляции.
+// Границы, число бинов и проектор — параметры шаблона, поэтому поиск бина
+// сводится к вычитанию и делению на константу (сдвиг, если ширина — степень
+// двойки), а проектор встраивается. Бины совпадают с MakeUniformBins(MinVal,
+// MaxVal, BinCount), результат ToDictionary() — с BuildHistogram.
+//
+//   typedef StaticHistogram<Person, int, 0, 100, 10, &ProjectAge> AgeHistogram;
+template <typename T, typename Key, Key MinVal, Key MaxVal, int BinCount, Key (*Projector)(const T&)>
+class StaticHistogram {
+    static_assert(std::is_integral<Key>::value, "StaticHistogram: Key must be an integer type");
+    static_assert(BinCount > 0, "StaticHistogram: BinCount must be > 0");
+    static_assert(MinVal <= MaxVal, "StaticHistogram: MinVal must be <= MaxVal");
+    static_assert(Projector != nullptr, "StaticHistogram: projector is null");
+
+public:
+    typedef typename std::make_unsigned<Key>::type Offset;
+
+    // Ширина бина по правилам MakeUniformBins
+    static constexpr Key kWidth = ((MaxVal - MinVal) / (Key)BinCount > 0)
+        ? (Key)((MaxVal - MinVal) / (Key)BinCount) : (Key)1;
+
+    static constexpr Range<Key> Bin(int i) {
+        return Range<Key>{ (Key)(MinVal + (Key)i * kWidth),
+                           (i == BinCount - 1) ? MaxVal : (Key)(MinVal + (Key)(i + 1) * kWidth) };
+    }
+
+    // Индекс бина или BinCount, если значение не попадает ни в один бин
+    static constexpr int Slot(Key value) {
+        if (value < MinVal) return BinCount;
+        Offset index = (Offset)((Offset)value - (Offset)MinVal) / (Offset)kWidth;
+        if (index < (Offset)(BinCount - 1)) return (int)index;
+        // последний бин — до MaxVal
+        return (value < MaxVal) ? BinCount - 1 : BinCount;
+    }
+
+    StaticHistogram() : counts() {}
+
+    void Add(const T& item) {
+        ++counts[Slot(Projector(item))];
+    }
+
+    void AddAll(const T* items, size_t n) {
+        // Лишняя ячейка counts[BinCount] собирает промахи — в цикле нет ветвлений
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            int s0 = Slot(Projector(items[i]));
+            int s1 = Slot(Projector(items[i + 1]));
+            int s2 = Slot(Projector(items[i + 2]));
+            int s3 = Slot(Projector(items[i + 3]));
+            ++counts[s0];
+            ++counts[s1];
+            ++counts[s2];
+            ++counts[s3];
+        }
+        for (; i < n; i++)
+            ++counts[Slot(Projector(items[i]))];
+    }
+
+    void AddAll(const ArraySequence<T>* seq) {
+        if (!seq) throw std::invalid_argument("StaticHistogram: seq is null");
+        AddAll(seq->GetData(), seq->GetLength());
+    }
+
+    int GetCount(int bin) const {
+        if (bin < 0 || bin >= BinCount) throw std::out_of_range("StaticHistogram: bin out of range");
+        return counts[bin];
+    }
+
+    const int* GetCounts() const {
+        return counts.data();
+    }
+
+    void Clear() {
+        counts.fill(0);
+    }
+
+    IDictionary< Range<Key>, int >* ToDictionary() const {
+        ArraySequence< Range<Key> >* bins = MakeUniformBins<Key>(MinVal, MaxVal, BinCount);
+        IDictionary< Range<Key>, int >* dict = MakeHistogramDictionary(bins, counts.data());
+        delete bins;
+        return dict;
+    }
+
+private:
+    std::array<int, BinCount + 1> counts;
+};
+
+// Замена BuildHistogram для фиксированной раскладки
+template <typename T, typename Key, Key MinVal, Key MaxVal, int BinCount, Key (*Projector)(const T&)>
+IDictionary< Range<Key>, int >* BuildStaticHistogram(ArraySequence<T>* seq) {
+    StaticHistogram<T, Key, MinVal, MaxVal, BinCount, Projector> hist;
+    hist.AddAll(seq);
+    return hist.ToDictionary();
+}
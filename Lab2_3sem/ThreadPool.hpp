@@ -0,0 +1,249 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Пул потоков с кражей работы.
+// У каждого рабочего потока своя очередь: владелец берёт задачи с конца (LIFO),
+// остальные воруют с начала (FIFO). Задачи, отправленные из рабочего потока,
+// попадают в его собственную очередь, внешние — раскладываются по кругу.
+// Исключения из задач, отправленных напрямую через Submit, не перехватываются;
+// ParallelFor / ParallelReduceChunks доставляют их вызывающему потоку.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = 0) : pending(0), nextQueue(0), stopping(false) {
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+        for (size_t i = 0; i < threads; i++)
+            queues.emplace_back(new WorkQueue());
+        try {
+            for (size_t i = 0; i < threads; i++)
+                workers.emplace_back([this, i] { WorkerLoop(i); });
+        } catch (...) {
+            Shutdown();
+            throw;
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        Shutdown();
+    }
+
+    size_t GetWorkerCount() const {
+        return workers.size();
+    }
+
+    void Submit(std::function<void()> task) {
+        if (!task) throw std::invalid_argument("ThreadPool: task is empty");
+        Worker& self = CurrentWorker();
+        size_t qi = (self.pool == this)
+            ? self.index
+            : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        // Счётчик увеличивается до публикации, чтобы TryPop не увёл его в минус
+        pending.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(queues[qi]->mutex);
+            queues[qi]->tasks.push_back(std::move(task));
+        }
+        {
+            // Пустая критическая секция исключает потерянное пробуждение
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wake.notify_one();
+    }
+
+    // Выполняет одну ожидающую задачу в вызывающем потоке (если есть).
+    // Используется ожидающими потоками, чтобы помогать, а не простаивать.
+    bool RunPendingTask() {
+        Worker& self = CurrentWorker();
+        size_t home = (self.pool == this) ? self.index : 0;
+        std::function<void()> task;
+        if ((self.pool == this && TryPop(home, task)) || TrySteal(home, task)) {
+            task();
+            return true;
+        }
+        return false;
+    }
+
+    // Общий пул на всё приложение
+    static ThreadPool& Default() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque< std::function<void()> > tasks;
+    };
+
+    struct Worker {
+        ThreadPool* pool;
+        size_t index;
+    };
+
+    std::vector< std::unique_ptr<WorkQueue> > queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pending;
+    std::atomic<size_t> nextQueue;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool stopping;
+
+    static Worker& CurrentWorker() {
+        static thread_local Worker worker = { nullptr, 0 };
+        return worker;
+    }
+
+    bool TryPop(size_t qi, std::function<void()>& task) {
+        WorkQueue& q = *queues[qi];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) return false;
+        task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        pending.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool TrySteal(size_t thief, std::function<void()>& task) {
+        size_t n = queues.size();
+        for (size_t k = 1; k <= n; k++) {
+            WorkQueue& q = *queues[(thief + k) % n];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) continue;
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void WorkerLoop(size_t index) {
+        CurrentWorker() = Worker{ this, index };
+        for (;;) {
+            std::function<void()> task;
+            if (TryPop(index, task) || TrySteal(index, task)) {
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this] { return stopping || pending.load(std::memory_order_acquire) > 0; });
+            if (stopping && pending.load(std::memory_order_acquire) == 0) return;
+        }
+    }
+
+    void Shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (size_t i = 0; i < workers.size(); i++)
+            if (workers[i].joinable()) workers[i].join();
+        workers.clear();
+    }
+};
+
+// Порядок свёртки для параллельных редукций.
+// Adaptive — размер куска зависит от числа потоков: результат детерминирован
+//            для данного пула, но может отличаться между машинами.
+// Pinned   — разбиение зависит только от длины данных: для чисел с плавающей
+//            точкой результат побитово одинаков при любом числе потоков.
+enum class ReduceOrder { Adaptive, Pinned };
+
+const size_t kDefaultGrain = 2048;
+
+inline size_t ParallelChunkSize(size_t n, size_t workers, size_t grain, ReduceOrder order) {
+    if (grain == 0) grain = 1;
+    // Pinned: не более 256 кусков независимо от пула; Adaptive: ~8 кусков на поток
+    size_t parts = (order == ReduceOrder::Pinned) ? 256 : workers * 8;
+    if (parts == 0) parts = 1;
+    size_t chunk = (n + parts - 1) / parts;
+    return (chunk < grain) ? grain : chunk;
+}
+
+namespace parallel_detail {
+    struct ForState {
+        std::atomic<size_t> remaining;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        explicit ForState(size_t count) : remaining(count) {}
+
+        void Fail() {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) error = std::current_exception();
+        }
+    };
+
+    // Запускает body(chunk, lo, hi) для каждого куска [lo, hi) и ждёт завершения.
+    // Вызывающий поток выполняет первый кусок сам и затем помогает пулу.
+    template <typename Body>
+    void RunChunks(ThreadPool& pool, size_t n, size_t chunk, Body& body) {
+        size_t chunks = (n + chunk - 1) / chunk;
+        if (chunks <= 1) {
+            if (n > 0) body(0, 0, n);
+            return;
+        }
+        ForState state(chunks - 1);
+        for (size_t c = 1; c < chunks; c++) {
+            size_t lo = c * chunk;
+            size_t hi = (lo + chunk < n) ? lo + chunk : n;
+            pool.Submit([&state, &body, c, lo, hi] {
+                try {
+                    body(c, lo, hi);
+                } catch (...) {
+                    state.Fail();
+                }
+                state.remaining.fetch_sub(1, std::memory_order_acq_rel);
+            });
+        }
+        try {
+            body(0, 0, (chunk < n) ? chunk : n);
+        } catch (...) {
+            state.Fail();
+        }
+        while (state.remaining.load(std::memory_order_acquire) > 0) {
+            if (!pool.RunPendingTask()) std::this_thread::yield();
+        }
+        if (state.error) std::rethrow_exception(state.error);
+    }
+}
+
+// body(lo, hi) для кусков [0, n); размер куска подбирается по числу потоков
+template <typename Body>
+void ParallelFor(ThreadPool& pool, size_t n, Body body, size_t grain = kDefaultGrain) {
+    size_t chunk = ParallelChunkSize(n, pool.GetWorkerCount(), grain, ReduceOrder::Adaptive);
+    auto run = [&body](size_t, size_t lo, size_t hi) { body(lo, hi); };
+    parallel_detail::RunChunks(pool, n, chunk, run);
+}
+
+// Редукция по кускам: chunkFn(lo, hi) -> Acc, затем частичные результаты
+// сворачиваются combine строго слева направо (в порядке индексов).
+template <typename Acc, typename ChunkFn, typename Combine>
+Acc ParallelReduceChunks(ThreadPool& pool, size_t n, Acc identity,
+                         ChunkFn chunkFn, Combine combine,
+                         ReduceOrder order = ReduceOrder::Pinned,
+                         size_t grain = kDefaultGrain)
+{
+    size_t chunk = ParallelChunkSize(n, pool.GetWorkerCount(), grain, order);
+    size_t chunks = (n + chunk - 1) / chunk;
+    if (chunks == 0) return identity;
+    std::vector<Acc> partials(chunks, identity);
+    auto run = [&partials, &chunkFn](size_t c, size_t lo, size_t hi) { partials[c] = chunkFn(lo, hi); };
+    parallel_detail::RunChunks(pool, n, chunk, run);
+    Acc result = identity;
+    for (size_t c = 0; c < chunks; c++)
+        result = combine(result, partials[c]);
+    return result;
+}
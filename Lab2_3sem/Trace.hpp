@@ -0,0 +1,159 @@
+#pragma once
+#include <atomic>
+#include <ostream>
+
+// Счётчики операций контейнеров (аллокации, копирования, Resize/rehash и т.п.).
+// Включаются флагом компиляции -DLAB2_TRACE; без него макрос LAB2_TRACE_EVENT
+// раскрывается в пустое выражение и ничего не стоит. Классы ниже доступны
+// всегда, так что код отчётов компилируется в обоих режимах (и печатает нули).
+//
+//   TraceScope scope;
+//   auto* H = BuildHistogram(people, hp);
+//   scope.GetDelta().WriteJson(std::cout);
+//
+// Счётчики глобальные (атомарные), поэтому TraceScope видит и работу пула
+// потоков, и всё, что параллельно делают другие потоки.
+
+enum class TraceContainer {
+    DynamicArray,
+    LinkedList,
+    ArraySequence,
+    ListSequence,
+    SmallArraySequence,
+    HashMap,
+    Count
+};
+
+enum class TraceEvent {
+    Allocations,     // обращений к куче
+    AllocatedBytes,  // байт запрошено
+    Copies,          // копирований элементов
+    Moves,           // сдвигов/переносов элементов внутри контейнера
+    Resizes,         // Resize и перераспределений буфера
+    Rehashes,        // перестроений хеш-таблицы
+    BoundsFailures,  // неудачных проверок индекса/ключа (с исключением)
+    Count
+};
+
+const int kTraceContainers = static_cast<int>(TraceContainer::Count);
+const int kTraceEvents = static_cast<int>(TraceEvent::Count);
+
+#ifdef LAB2_TRACE
+const bool kTraceEnabled = true;
+#define LAB2_TRACE_EVENT(container, event, amount) \
+    TraceCounters::Add(TraceContainer::container, TraceEvent::event, (unsigned long long)(amount))
+#else
+const bool kTraceEnabled = false;
+#define LAB2_TRACE_EVENT(container, event, amount) ((void)0)
+#endif
+
+inline const char* TraceContainerName(int c) {
+    static const char* names[kTraceContainers] = {
+        "DynamicArray", "LinkedList", "ArraySequence", "ListSequence", "SmallArraySequence", "HashMap"
+    };
+    return names[c];
+}
+
+inline const char* TraceEventName(int e) {
+    static const char* names[kTraceEvents] = {
+        "allocations", "allocated_bytes", "copies", "moves", "resizes", "rehashes", "bounds_failures"
+    };
+    return names[e];
+}
+
+// Снимок всех счётчиков; разность двух снимков — вклад участка кода
+struct TraceSnapshot {
+    unsigned long long values[kTraceContainers][kTraceEvents];
+
+    TraceSnapshot() : values() {}
+
+    unsigned long long Get(TraceContainer c, TraceEvent e) const {
+        return values[static_cast<int>(c)][static_cast<int>(e)];
+    }
+
+    TraceSnapshot operator-(const TraceSnapshot& other) const {
+        TraceSnapshot d;
+        for (int c = 0; c < kTraceContainers; c++)
+            for (int e = 0; e < kTraceEvents; e++)
+                d.values[c][e] = values[c][e] - other.values[c][e];
+        return d;
+    }
+
+    // Таблица; контейнеры без событий пропускаются
+    void WriteText(std::ostream& out) const {
+        out << "container            ";
+        for (int e = 0; e < kTraceEvents; e++) out << " " << TraceEventName(e);
+        out << "\n";
+        for (int c = 0; c < kTraceContainers; c++) {
+            if (IsEmpty(c)) continue;
+            out << TraceContainerName(c);
+            for (int pad = 0; pad < 21 - (int)std::char_traits<char>::length(TraceContainerName(c)); pad++) out << ' ';
+            for (int e = 0; e < kTraceEvents; e++) {
+                out << " ";
+                out.width((std::streamsize)std::char_traits<char>::length(TraceEventName(e)));
+                out << values[c][e];
+            }
+            out << "\n";
+        }
+    }
+
+    // {"DynamicArray": {"allocations": 3, ...}, ...} — все контейнеры, для сравнения между прогонами
+    void WriteJson(std::ostream& out) const {
+        out << "{";
+        for (int c = 0; c < kTraceContainers; c++) {
+            out << (c ? ", " : "") << "\"" << TraceContainerName(c) << "\": {";
+            for (int e = 0; e < kTraceEvents; e++)
+                out << (e ? ", " : "") << "\"" << TraceEventName(e) << "\": " << values[c][e];
+            out << "}";
+        }
+        out << "}\n";
+    }
+
+private:
+    bool IsEmpty(int c) const {
+        for (int e = 0; e < kTraceEvents; e++)
+            if (values[c][e]) return false;
+        return true;
+    }
+};
+
+class TraceCounters {
+public:
+    static void Add(TraceContainer c, TraceEvent e, unsigned long long amount) {
+        Slot(c, e).fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    static TraceSnapshot Snapshot() {
+        TraceSnapshot s;
+        for (int c = 0; c < kTraceContainers; c++)
+            for (int e = 0; e < kTraceEvents; e++)
+                s.values[c][e] = Slot(static_cast<TraceContainer>(c), static_cast<TraceEvent>(e))
+                                     .load(std::memory_order_relaxed);
+        return s;
+    }
+
+    static void Reset() {
+        for (int c = 0; c < kTraceContainers; c++)
+            for (int e = 0; e < kTraceEvents; e++)
+                Slot(static_cast<TraceContainer>(c), static_cast<TraceEvent>(e)).store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static std::atomic<unsigned long long>& Slot(TraceContainer c, TraceEvent e) {
+        static std::atomic<unsigned long long> counters[kTraceContainers][kTraceEvents];
+        return counters[static_cast<int>(c)][static_cast<int>(e)];
+    }
+};
+
+// Считает события от создания до GetDelta()
+class TraceScope {
+public:
+    TraceScope() : start(TraceCounters::Snapshot()) {}
+
+    TraceSnapshot GetDelta() const {
+        return TraceCounters::Snapshot() - start;
+    }
+
+private:
+    TraceSnapshot start;
+};